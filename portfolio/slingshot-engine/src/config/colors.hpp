@@ -74,6 +74,7 @@ namespace slingshot
 
             constexpr Color SLINGSHOT_LINE = ACCENT_PRIMARY;
             constexpr Color SLINGSHOT_ANCHOR = ACCENT_HOVER;
+            constexpr Color TRAJECTORY_PREVIEW = TEXT_MUTED.withAlpha(140);
         }
 
         // UI colors
@@ -41,8 +41,47 @@ namespace slingshot
 
         // Simulation settings
         constexpr float TIME_STEP = 1.0f / 60.0f;
+        constexpr int MAX_STEPS_PER_FRAME = 5; // Catch-up cap; beyond it game time slows down
         constexpr int MAX_TRAIL_POINTS = 100;
 
+        // Barnes-Hut gravity (used automatically above the body threshold)
+        // Opening angle: smaller is more accurate, larger is faster
+        // Threshold is the measured crossover against the four-lane SIMD direct
+        // sum (SSE2, which deterministic builds use as well)
+        constexpr float BARNES_HUT_THETA = 0.5f;
+        constexpr int BARNES_HUT_THRESHOLD = 3000;
+
+        // Multi-threaded force evaluation (PhysicsWorld::setThreadCount): smaller
+        // worlds stay on one thread, where waking workers costs more than it saves.
+        // Target bodies are handed out in chunks of PARALLEL_GRAIN.
+        constexpr int PARALLEL_MIN_BODIES = 512;
+        constexpr int PARALLEL_GRAIN = 64;
+
+        // Adaptive sub-stepping near close encounters: a body is sub-stepped when
+        // it would cover more than this fraction of the gap to the nearest
+        // gravity source surface in one step, or turn by more than this many
+        // radians
+        constexpr float SUBSTEP_TRAVEL_RATIO = 0.25f;
+        constexpr float SUBSTEP_MAX_TURN = 0.05f;
+        constexpr int MAX_SUBSTEPS = 32;
+
+        // Cell size of the broad-phase collision grid (covers the world plus BOUNDS_MARGIN)
+        constexpr float GRID_CELL_SIZE = 100.0f;
+
+        // Trajectory preview while aiming
+        constexpr int PREVIEW_STEPS = 180;          // 3 seconds of flight
+        constexpr int PREVIEW_SAMPLE_INTERVAL = 3;  // Keep every Nth step as a path point
+        constexpr float PREVIEW_GRID = 2.0f;        // Drag positions are cached per grid cell
+        constexpr int PREVIEW_CACHE_SIZE = 256;
+
+        // Built with SLINGSHOT_DETERMINISTIC: steps are bit-identical across
+        // targets, so replays recorded in one build verify in another
+#ifdef SLINGSHOT_DETERMINISTIC
+        constexpr bool DETERMINISTIC = true;
+#else
+        constexpr bool DETERMINISTIC = false;
+#endif
+
     } // namespace physics
 } // namespace slingshot
 
@@ -0,0 +1,76 @@
+#ifndef SLINGSHOT_CORE_BYTE_IO_HPP
+#define SLINGSHOT_CORE_BYTE_IO_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include "math/vec2.hpp"
+
+namespace slingshot
+{
+
+    // Little-endian field access for the binary file formats. Fields are
+    // assembled byte by byte, which is endian-independent and free of
+    // alignment requirements; compilers fold it into single loads and stores.
+    namespace byte_io
+    {
+        inline uint16_t readU16(const uint8_t *p)
+        {
+            return static_cast<uint16_t>(p[0] | (p[1] << 8));
+        }
+
+        inline uint32_t readU32(const uint8_t *p)
+        {
+            return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+                   (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+        }
+
+        inline float readF32(const uint8_t *p)
+        {
+            uint32_t bits = readU32(p);
+            float value;
+            std::memcpy(&value, &bits, sizeof(value));
+            return value;
+        }
+
+        inline Vec2 readVec2(const uint8_t *p)
+        {
+            return Vec2(readF32(p), readF32(p + 4));
+        }
+
+        inline void writeU16(std::vector<uint8_t> &out, uint16_t value)
+        {
+            out.push_back(static_cast<uint8_t>(value));
+            out.push_back(static_cast<uint8_t>(value >> 8));
+        }
+
+        inline void writeU32(std::vector<uint8_t> &out, uint32_t value)
+        {
+            for (int shift = 0; shift < 32; shift += 8)
+                out.push_back(static_cast<uint8_t>(value >> shift));
+        }
+
+        inline void writeF32(std::vector<uint8_t> &out, float value)
+        {
+            uint32_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            writeU32(out, bits);
+        }
+
+        inline void writeVec2(std::vector<uint8_t> &out, Vec2 value)
+        {
+            writeF32(out, value.x);
+            writeF32(out, value.y);
+        }
+
+        // Overwrites a u32 written earlier, e.g. a size known only at the end
+        inline void patchU32(std::vector<uint8_t> &out, size_t at, uint32_t value)
+        {
+            for (int i = 0; i < 4; i++)
+                out[at + i] = static_cast<uint8_t>(value >> (8 * i));
+        }
+    }
+
+} // namespace slingshot
+
+#endif
@@ -1,46 +1,48 @@
 #ifndef SLINGSHOT_CORE_RENDERER_HPP
 #define SLINGSHOT_CORE_RENDERER_HPP
 
-#include <SDL2/SDL.h>
 #include <vector>
+#include "core/ring_buffer.hpp"
 #include "math/vec2.hpp"
 #include "config/colors.hpp"
+#include "config/physics.hpp"
 
 namespace slingshot
 {
 
+    // Recent agent positions, oldest first
+    using Trail = RingBuffer<Vec2, physics::MAX_TRAIL_POINTS>;
+
+    // Drawing interface used by entities and the game. Coordinates are in
+    // world units; backends (e.g. SdlRenderer) map them to the screen.
     class Renderer
     {
     public:
-        void init(SDL_Renderer *renderer);
-        void setScale(float scale, float offsetX, float offsetY);
-
-        // Screen coordinate conversion (for entities to use)
-        int toScreenX(float worldX) const;
-        int toScreenY(float worldY) const;
-        int toScreenSize(float worldSize) const;
+        virtual ~Renderer() = default;
 
         // Primitives
-        void clear(const colors::Color &color);
-        void drawCircle(Vec2 center, float radius, const colors::Color &color);
-        void fillCircle(Vec2 center, float radius, const colors::Color &color);
-        void drawLine(Vec2 a, Vec2 b, const colors::Color &color);
-        void drawDashedLine(Vec2 a, Vec2 b, const colors::Color &color, float dashLength = 10.0f);
+        virtual void clear(const colors::Color &color) = 0;
+        virtual void drawCircle(Vec2 center, float radius, const colors::Color &color) = 0;
+        virtual void fillCircle(Vec2 center, float radius, const colors::Color &color) = 0;
+        virtual void drawLine(Vec2 a, Vec2 b, const colors::Color &color) = 0;
+        virtual void drawDashedLine(Vec2 a, Vec2 b, const colors::Color &color, float dashLength = 10.0f) = 0;
 
         // Effects
-        void drawGlow(Vec2 center, float innerRadius, float outerRadius, const colors::Color &color);
-        void drawTrail(const std::vector<Vec2> &trail, const colors::Color &color);
+        virtual void drawGlow(Vec2 center, float innerRadius, float outerRadius, const colors::Color &color) = 0;
+        virtual void drawTrail(const Trail &trail, const colors::Color &color) = 0;
 
-        // UI elements
+        // UI elements (built from the primitives above)
         void drawSlingshot(Vec2 anchor, Vec2 current, float maxRadius);
 
-        void present();
+        // Static layer for content that does not change between frames.
+        // Usage: if (beginStaticLayer()) { draw...; endStaticLayer(); }
+        // A caching backend draws its stored copy and returns false while it
+        // is valid; otherwise the content is drawn (and possibly captured) now.
+        virtual bool beginStaticLayer() { return true; }
+        virtual void endStaticLayer() {}
+        virtual void invalidateStaticLayer() {}
 
-    private:
-        SDL_Renderer *m_renderer = nullptr;
-        float m_scale = 1.0f;
-        float m_offsetX = 0.0f;
-        float m_offsetY = 0.0f;
+        virtual void present() = 0;
     };
 
 } // namespace slingshot
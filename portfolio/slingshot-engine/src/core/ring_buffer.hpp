@@ -0,0 +1,48 @@
+#ifndef SLINGSHOT_CORE_RING_BUFFER_HPP
+#define SLINGSHOT_CORE_RING_BUFFER_HPP
+
+#include <array>
+#include <cstddef>
+
+namespace slingshot
+{
+
+    // Fixed-capacity FIFO that overwrites its oldest element when full.
+    // Indexing runs from oldest (0) to newest (size() - 1).
+    template <typename T, size_t Capacity>
+    class RingBuffer
+    {
+        static_assert(Capacity > 0, "RingBuffer needs a non-zero capacity");
+
+    public:
+        static constexpr size_t capacity() { return Capacity; }
+        size_t size() const { return m_size; }
+        bool empty() const { return m_size == 0; }
+
+        void push(const T &value)
+        {
+            m_items[(m_head + m_size) % Capacity] = value;
+            if (m_size < Capacity)
+                m_size++;
+            else
+                m_head = (m_head + 1) % Capacity;
+        }
+
+        void clear()
+        {
+            m_head = 0;
+            m_size = 0;
+        }
+
+        const T &operator[](size_t i) const { return m_items[(m_head + i) % Capacity]; }
+        const T &back() const { return (*this)[m_size - 1]; }
+
+    private:
+        std::array<T, Capacity> m_items{};
+        size_t m_head = 0; // Index of the oldest element
+        size_t m_size = 0;
+    };
+
+} // namespace slingshot
+
+#endif
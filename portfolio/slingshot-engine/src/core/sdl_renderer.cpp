@@ -0,0 +1,432 @@
+#include "core/sdl_renderer.hpp"
+#include "config/colors.hpp"
+#include "math/circle_table.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace slingshot
+{
+
+    namespace
+    {
+        // Glow ratios are bucketed to 1/64 of the outer radius (a texel at 128 px)
+        constexpr int GLOW_RATIO_STEPS = 64;
+
+        // Opacity at the inner edge of a glow, falling off quadratically to zero
+        constexpr float GLOW_PEAK_OPACITY = 0.6f;
+
+        // Agent trail thickness in screen pixels
+        constexpr float TRAIL_WIDTH = 2.0f;
+    }
+
+    SdlRenderer::~SdlRenderer()
+    {
+        if (m_staticLayer)
+            SDL_DestroyTexture(m_staticLayer);
+        if (m_atlas)
+            SDL_DestroyTexture(m_atlas);
+    }
+
+    void SdlRenderer::init(SDL_Renderer *renderer)
+    {
+        m_renderer = renderer;
+        SDL_SetRenderDrawBlendMode(m_renderer, SDL_BLENDMODE_BLEND);
+        createAtlas();
+    }
+
+    void SdlRenderer::createAtlas()
+    {
+        m_atlas = SDL_CreateTexture(m_renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STATIC, ATLAS_SIZE, ATLAS_SIZE);
+        if (!m_atlas)
+            return;
+
+        SDL_SetTextureBlendMode(m_atlas, SDL_BLENDMODE_BLEND);
+        SDL_SetTextureScaleMode(m_atlas, SDL_ScaleModeLinear);
+
+        std::vector<uint32_t> solid(SPRITE_SIZE * SPRITE_SIZE, 0xFFFFFFFFu);
+        SDL_Rect slot = {0, 0, SPRITE_SIZE, SPRITE_SIZE};
+        SDL_UpdateTexture(m_atlas, &slot, solid.data(), SPRITE_SIZE * 4);
+
+        // Sample the middle of the solid slot so filtering never reaches a neighbour
+        m_solidUV = {0.5f * SPRITE_SIZE / ATLAS_SIZE, 0.5f * SPRITE_SIZE / ATLAS_SIZE};
+        m_glowKeys.clear();
+    }
+
+    int SdlRenderer::getGlowSlot(float innerRatio)
+    {
+        int key = static_cast<int>(std::lround(innerRatio * GLOW_RATIO_STEPS));
+        for (size_t i = 0; i < m_glowKeys.size(); i++)
+        {
+            if (m_glowKeys[i] == key)
+                return static_cast<int>(i) + 1;
+        }
+        if (!m_atlas || m_glowKeys.size() + 1 >= static_cast<size_t>(ATLAS_SLOTS))
+            return -1;
+
+        // White radial gradient between the inner and outer radius, 1 texel of
+        // anti-aliasing at the inner edge; colour comes from the vertices
+        float inner = static_cast<float>(key) / GLOW_RATIO_STEPS;
+        float half = 0.5f * SPRITE_SIZE;
+        std::vector<uint32_t> pixels(SPRITE_SIZE * SPRITE_SIZE);
+        for (int y = 0; y < SPRITE_SIZE; y++)
+        {
+            for (int x = 0; x < SPRITE_SIZE; x++)
+            {
+                float dx = (x + 0.5f - half) / half;
+                float dy = (y + 0.5f - half) / half;
+                float rho = std::sqrt(dx * dx + dy * dy);
+
+                float alpha = 0.0f;
+                if (rho < 1.0f && inner < 1.0f)
+                {
+                    float t = std::max(rho - inner, 0.0f) / (1.0f - inner);
+                    float edge = std::min(std::max((rho - inner) * half + 0.5f, 0.0f), 1.0f);
+                    alpha = GLOW_PEAK_OPACITY * (1.0f - t) * (1.0f - t) * edge;
+                }
+                // RGBA32 is byte order R, G, B, A regardless of endianness
+                uint8_t bytes[4] = {255, 255, 255, static_cast<uint8_t>(alpha * 255.0f + 0.5f)};
+                std::memcpy(&pixels[static_cast<size_t>(y * SPRITE_SIZE + x)], bytes, 4);
+            }
+        }
+
+        int slot = static_cast<int>(m_glowKeys.size()) + 1;
+        int perRow = ATLAS_SIZE / SPRITE_SIZE;
+        SDL_Rect rect = {(slot % perRow) * SPRITE_SIZE, (slot / perRow) * SPRITE_SIZE, SPRITE_SIZE, SPRITE_SIZE};
+        SDL_UpdateTexture(m_atlas, &rect, pixels.data(), SPRITE_SIZE * 4);
+        m_glowKeys.push_back(key);
+        return slot;
+    }
+
+    void SdlRenderer::setScale(float scale, float offsetX, float offsetY)
+    {
+        if (scale != m_scale || offsetX != m_offsetX || offsetY != m_offsetY)
+        {
+            invalidateStaticLayer();
+        }
+        m_scale = scale;
+        m_offsetX = offsetX;
+        m_offsetY = offsetY;
+    }
+
+    int SdlRenderer::toScreenX(float worldX) const
+    {
+        return static_cast<int>(worldX * m_scale + m_offsetX);
+    }
+
+    int SdlRenderer::toScreenY(float worldY) const
+    {
+        return static_cast<int>(worldY * m_scale + m_offsetY);
+    }
+
+    int SdlRenderer::toScreenSize(float worldSize) const
+    {
+        return static_cast<int>(worldSize * m_scale);
+    }
+
+    void SdlRenderer::clear(const colors::Color &color)
+    {
+        // Anything still batched would be cleared over anyway
+        m_vertices.clear();
+        m_indices.clear();
+
+        setDrawColor(color);
+        SDL_RenderClear(m_renderer);
+    }
+
+    void SdlRenderer::drawCircle(Vec2 center, float radius, const colors::Color &color)
+    {
+        flushBatch();
+        setDrawColor(color);
+
+        int cx = toScreenX(center.x);
+        int cy = toScreenY(center.y);
+        const std::vector<SDL_Point> &outline = getOutline(toScreenSize(radius), OUTLINE_SEGMENTS);
+
+        m_linePoints.resize(outline.size());
+        for (size_t i = 0; i < outline.size(); i++)
+        {
+            m_linePoints[i] = {cx + outline[i].x, cy + outline[i].y};
+        }
+        SDL_RenderDrawLines(m_renderer, m_linePoints.data(), static_cast<int>(m_linePoints.size()));
+        m_frame.drawCalls++;
+    }
+
+    const std::vector<SDL_Point> &SdlRenderer::getOutline(int radius, int segments)
+    {
+        uint32_t key = (static_cast<uint32_t>(radius) << 8) | static_cast<uint32_t>(segments);
+        auto it = m_outlines.find(key);
+        if (it != m_outlines.end())
+            return it->second;
+
+        // Radii follow the zoom level, so a resize leaves a new set behind
+        if (m_outlines.size() >= MAX_CACHED_OUTLINES)
+            m_outlines.clear();
+
+        // Closed polyline relative to the centre (last point repeats the first)
+        std::vector<SDL_Point> &outline = m_outlines[key];
+        outline.reserve(segments + 1);
+        for (int i = 0; i <= segments; i++)
+        {
+            outline.push_back({static_cast<int>(circle_table::cosAt(i, segments) * radius),
+                               static_cast<int>(circle_table::sinAt(i, segments) * radius)});
+        }
+        return outline;
+    }
+
+    void SdlRenderer::fillCircle(Vec2 center, float radius, const colors::Color &color)
+    {
+        float cx = center.x * m_scale + m_offsetX;
+        float cy = center.y * m_scale + m_offsetY;
+        float r = radius * m_scale;
+        if (r <= 0.0f)
+            return;
+
+        // Fewest power-of-two segments that keep the polygon within half a
+        // pixel of the circle, so the points come straight from the table
+        int segments = 8;
+        while (segments < 128 && r * (1.0f - circle_table::cosAt(1, segments)) > 0.5f)
+        {
+            segments *= 2;
+        }
+
+        SDL_Color c = {color.r, color.g, color.b, color.a};
+        int base = static_cast<int>(m_vertices.size());
+
+        // Triangle fan around the centre, emitted as an indexed triangle list
+        m_vertices.push_back({{cx, cy}, c, m_solidUV});
+        for (int i = 0; i < segments; i++)
+        {
+            float x = cx + circle_table::cosAt(i, segments) * r;
+            float y = cy + circle_table::sinAt(i, segments) * r;
+            m_vertices.push_back({{x, y}, c, m_solidUV});
+        }
+        for (int i = 0; i < segments; i++)
+        {
+            m_indices.push_back(base);
+            m_indices.push_back(base + 1 + i);
+            m_indices.push_back(base + 1 + (i + 1) % segments);
+        }
+    }
+
+    void SdlRenderer::drawLine(Vec2 a, Vec2 b, const colors::Color &color)
+    {
+        flushBatch();
+        setDrawColor(color);
+        SDL_RenderDrawLine(
+            m_renderer,
+            toScreenX(a.x), toScreenY(a.y),
+            toScreenX(b.x), toScreenY(b.y));
+        m_frame.drawCalls++;
+    }
+
+    void SdlRenderer::drawDashedLine(Vec2 a, Vec2 b, const colors::Color &color, float dashLength)
+    {
+        flushBatch();
+        setDrawColor(color);
+
+        Vec2 dir = b - a;
+        float length = dir.magnitude();
+        if (length < 0.001f)
+            return;
+
+        Vec2 norm = dir / length;
+        float traveled = 0.0f;
+        bool drawing = true;
+
+        while (traveled < length)
+        {
+            float segEnd = std::min(traveled + dashLength, length);
+            if (drawing)
+            {
+                Vec2 start = a + norm * traveled;
+                Vec2 end = a + norm * segEnd;
+                SDL_RenderDrawLine(
+                    m_renderer,
+                    toScreenX(start.x), toScreenY(start.y),
+                    toScreenX(end.x), toScreenY(end.y));
+                m_frame.drawCalls++;
+            }
+            traveled = segEnd;
+            drawing = !drawing;
+        }
+    }
+
+    void SdlRenderer::drawGlow(Vec2 center, float innerRadius, float outerRadius, const colors::Color &color)
+    {
+        int slot = outerRadius > 0.0f ? getGlowSlot(innerRadius / outerRadius) : -1;
+        if (slot < 0)
+        {
+            drawGlowRings(center, innerRadius, outerRadius, color);
+            return;
+        }
+
+        // One textured quad covering the outer radius
+        float cx = center.x * m_scale + m_offsetX;
+        float cy = center.y * m_scale + m_offsetY;
+        float r = outerRadius * m_scale;
+
+        // Inset by half a texel so linear filtering stays inside the slot
+        int perRow = ATLAS_SIZE / SPRITE_SIZE;
+        float inset = 0.5f / ATLAS_SIZE;
+        float u0 = static_cast<float>((slot % perRow) * SPRITE_SIZE) / ATLAS_SIZE + inset;
+        float v0 = static_cast<float>((slot / perRow) * SPRITE_SIZE) / ATLAS_SIZE + inset;
+        float u1 = u0 + static_cast<float>(SPRITE_SIZE) / ATLAS_SIZE - 2.0f * inset;
+        float v1 = v0 + static_cast<float>(SPRITE_SIZE) / ATLAS_SIZE - 2.0f * inset;
+
+        SDL_Color c = {color.r, color.g, color.b, color.a};
+        int base = static_cast<int>(m_vertices.size());
+        m_vertices.push_back({{cx - r, cy - r}, c, {u0, v0}});
+        m_vertices.push_back({{cx + r, cy - r}, c, {u1, v0}});
+        m_vertices.push_back({{cx + r, cy + r}, c, {u1, v1}});
+        m_vertices.push_back({{cx - r, cy + r}, c, {u0, v1}});
+        for (int i : {0, 1, 2, 0, 2, 3})
+        {
+            m_indices.push_back(base + i);
+        }
+    }
+
+    void SdlRenderer::drawGlowRings(Vec2 center, float innerRadius, float outerRadius, const colors::Color &color)
+    {
+        // Fallback when the atlas is unavailable or full
+        int steps = 4;
+        for (int i = 0; i < steps; i++)
+        {
+            float t = static_cast<float>(i) / (steps - 1);
+            float radius = innerRadius + (outerRadius - innerRadius) * t;
+            uint8_t alpha = static_cast<uint8_t>(color.a * (1.0f - t * 0.7f));
+            drawCircle(center, radius, colors::Color(color.r, color.g, color.b, alpha));
+        }
+    }
+
+    void SdlRenderer::drawTrail(const Trail &trail, const colors::Color &color)
+    {
+        size_t count = trail.size();
+        if (count < 2)
+            return;
+
+        // One strip of quads in the geometry batch; alpha fades in quadratically
+        // from the oldest point, interpolated along each segment
+        float halfWidth = 0.5f * TRAIL_WIDTH;
+        int base = static_cast<int>(m_vertices.size());
+        for (size_t i = 0; i < count; i++)
+        {
+            Vec2 p = trail[i] * m_scale + Vec2(m_offsetX, m_offsetY);
+            Vec2 prev = trail[i > 0 ? i - 1 : i];
+            Vec2 next = trail[i + 1 < count ? i + 1 : i];
+            Vec2 side = (next - prev).normalized().perpendicular() * halfWidth;
+
+            float t = static_cast<float>(i + 1) / count;
+            SDL_Color c = {color.r, color.g, color.b, static_cast<uint8_t>(color.a * t * t)};
+            m_vertices.push_back({{p.x + side.x, p.y + side.y}, c, m_solidUV});
+            m_vertices.push_back({{p.x - side.x, p.y - side.y}, c, m_solidUV});
+        }
+        for (int i = 0; i + 1 < static_cast<int>(count); i++)
+        {
+            int a = base + 2 * i;
+            for (int k : {0, 1, 2, 1, 3, 2})
+            {
+                m_indices.push_back(a + k);
+            }
+        }
+    }
+
+    void SdlRenderer::present()
+    {
+        flushBatch();
+        SDL_RenderPresent(m_renderer);
+
+        m_lastFrame = m_frame;
+        m_frame = RenderStats();
+    }
+
+    bool SdlRenderer::beginStaticLayer()
+    {
+        flushBatch();
+
+        int width = 0;
+        int height = 0;
+        SDL_GetRendererOutputSize(m_renderer, &width, &height);
+        if (m_staticLayer && (width != m_staticWidth || height != m_staticHeight))
+        {
+            SDL_DestroyTexture(m_staticLayer);
+            m_staticLayer = nullptr;
+            m_staticValid = false;
+        }
+
+        if (m_staticValid)
+        {
+            compositeStaticLayer();
+            return false;
+        }
+
+        if (!m_staticLayer)
+        {
+            m_staticLayer = SDL_CreateTexture(m_renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_TARGET, width, height);
+            m_staticWidth = width;
+            m_staticHeight = height;
+        }
+
+        // Without a render target, draw straight into the frame every time
+        m_capturingStatic = m_staticLayer && SDL_SetRenderTarget(m_renderer, m_staticLayer) == 0;
+        if (m_capturingStatic)
+        {
+            SDL_SetRenderDrawColor(m_renderer, 0, 0, 0, 0);
+            SDL_RenderClear(m_renderer);
+        }
+        return true;
+    }
+
+    void SdlRenderer::endStaticLayer()
+    {
+        if (!m_capturingStatic)
+            return;
+
+        flushBatch();
+        SDL_SetRenderTarget(m_renderer, nullptr);
+        m_capturingStatic = false;
+        m_staticValid = true;
+        compositeStaticLayer();
+    }
+
+    void SdlRenderer::invalidateStaticLayer()
+    {
+        m_staticValid = false;
+    }
+
+    void SdlRenderer::compositeStaticLayer()
+    {
+        // Alpha-blending onto a transparent target leaves premultiplied colour,
+        // so the layer goes back on with a premultiplied "over"
+        SDL_BlendMode premultiplied = SDL_ComposeCustomBlendMode(
+            SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD,
+            SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD);
+        SDL_SetTextureBlendMode(m_staticLayer, premultiplied);
+        SDL_RenderCopy(m_renderer, m_staticLayer, nullptr, nullptr);
+        m_frame.drawCalls++;
+    }
+
+    void SdlRenderer::flushBatch()
+    {
+        if (m_indices.empty())
+            return;
+
+        SDL_RenderGeometry(
+            m_renderer, m_atlas,
+            m_vertices.data(), static_cast<int>(m_vertices.size()),
+            m_indices.data(), static_cast<int>(m_indices.size()));
+
+        m_frame.drawCalls++;
+        m_frame.batches++;
+        m_frame.vertices += static_cast<uint32_t>(m_vertices.size());
+
+        m_vertices.clear();
+        m_indices.clear();
+    }
+
+    void SdlRenderer::setDrawColor(const colors::Color &color)
+    {
+        SDL_SetRenderDrawColor(m_renderer, color.r, color.g, color.b, color.a);
+    }
+
+} // namespace slingshot
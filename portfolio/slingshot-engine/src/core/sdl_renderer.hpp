@@ -0,0 +1,108 @@
+#ifndef SLINGSHOT_CORE_SDL_RENDERER_HPP
+#define SLINGSHOT_CORE_SDL_RENDERER_HPP
+
+#include <SDL2/SDL.h>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "core/renderer.hpp"
+#include "math/vec2.hpp"
+#include "config/colors.hpp"
+
+namespace slingshot
+{
+
+    // Per-frame submission counters, for checking how much batching saves
+    struct RenderStats
+    {
+        uint32_t drawCalls = 0; // SDL_Render* calls that draw something
+        uint32_t vertices = 0;  // Vertices submitted through SDL_RenderGeometry
+        uint32_t batches = 0;   // Of the draw calls, how many were geometry batches
+    };
+
+    // Renderer backed by SDL2 (WebGL2 under Emscripten).
+    // Filled shapes are accumulated as triangles and submitted together with
+    // SDL_RenderGeometry; the batch is flushed before any line primitive and
+    // at present(), so draw order is unchanged. Fills and glows share one
+    // sprite atlas texture, so they batch together.
+    class SdlRenderer : public Renderer
+    {
+    public:
+        ~SdlRenderer() override;
+
+        void init(SDL_Renderer *renderer);
+        void setScale(float scale, float offsetX, float offsetY);
+
+        // Screen coordinate conversion (for entities to use)
+        int toScreenX(float worldX) const;
+        int toScreenY(float worldY) const;
+        int toScreenSize(float worldSize) const;
+
+        // Primitives
+        void clear(const colors::Color &color) override;
+        void drawCircle(Vec2 center, float radius, const colors::Color &color) override;
+        void fillCircle(Vec2 center, float radius, const colors::Color &color) override;
+        void drawLine(Vec2 a, Vec2 b, const colors::Color &color) override;
+        void drawDashedLine(Vec2 a, Vec2 b, const colors::Color &color, float dashLength = 10.0f) override;
+
+        // Effects
+        void drawGlow(Vec2 center, float innerRadius, float outerRadius, const colors::Color &color) override;
+        void drawTrail(const Trail &trail, const colors::Color &color) override;
+
+        void present() override;
+
+        // Pinned scene content is drawn once into a render-target texture and
+        // composited each frame until the scale changes or it is invalidated
+        bool beginStaticLayer() override;
+        void endStaticLayer() override;
+        void invalidateStaticLayer() override;
+
+        // Counters for the last presented frame
+        const RenderStats &getFrameStats() const { return m_lastFrame; }
+
+    private:
+        static constexpr int OUTLINE_SEGMENTS = 48;
+        static constexpr size_t MAX_CACHED_OUTLINES = 512;
+
+        // Atlas of white sprites tinted per vertex: slot 0 is solid (for fills),
+        // the rest hold radial glow gradients, one per inner/outer radius ratio
+        static constexpr int ATLAS_SIZE = 512;
+        static constexpr int SPRITE_SIZE = 128;
+        static constexpr int ATLAS_SLOTS = (ATLAS_SIZE / SPRITE_SIZE) * (ATLAS_SIZE / SPRITE_SIZE);
+
+        void createAtlas();
+        int getGlowSlot(float innerRatio);
+        void drawGlowRings(Vec2 center, float innerRadius, float outerRadius, const colors::Color &color);
+
+        // Cached screen-space outline for a circle of `radius` pixels
+        const std::vector<SDL_Point> &getOutline(int radius, int segments);
+        void flushBatch();
+        void compositeStaticLayer();
+        void setDrawColor(const colors::Color &color);
+
+        SDL_Renderer *m_renderer = nullptr;
+        float m_scale = 1.0f;
+        float m_offsetX = 0.0f;
+        float m_offsetY = 0.0f;
+
+        std::vector<SDL_Vertex> m_vertices;
+        std::vector<int> m_indices;
+        std::unordered_map<uint32_t, std::vector<SDL_Point>> m_outlines;
+        std::vector<SDL_Point> m_linePoints;
+        RenderStats m_frame;
+        RenderStats m_lastFrame;
+
+        SDL_Texture *m_atlas = nullptr;
+        std::vector<int> m_glowKeys; // Quantised inner/outer ratio of each glow slot (slot i + 1)
+        SDL_FPoint m_solidUV = {0.0f, 0.0f};
+
+        SDL_Texture *m_staticLayer = nullptr;
+        int m_staticWidth = 0;
+        int m_staticHeight = 0;
+        bool m_staticValid = false;
+        bool m_capturingStatic = false;
+    };
+
+} // namespace slingshot
+
+#endif
@@ -0,0 +1,118 @@
+#include "core/thread_pool.hpp"
+#include <algorithm>
+
+namespace slingshot
+{
+
+    ThreadPool::ThreadPool(int threads)
+    {
+        setThreadCount(threads);
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        stopWorkers();
+    }
+
+    int ThreadPool::hardwareThreads()
+    {
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+        return 1;
+#else
+        return std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+#endif
+    }
+
+    void ThreadPool::setThreadCount(int threads)
+    {
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+        threads = 1;
+#endif
+        threads = std::max(threads, 1);
+        if (threads == getThreadCount())
+            return;
+
+        stopWorkers();
+        m_quit = false;
+        for (int i = 1; i < threads; i++)
+        {
+            m_workers.emplace_back(&ThreadPool::workerLoop, this, m_generation);
+        }
+    }
+
+    void ThreadPool::stopWorkers()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_quit = true;
+        }
+        m_wake.notify_all();
+        for (auto &worker : m_workers)
+        {
+            worker.join();
+        }
+        m_workers.clear();
+    }
+
+    void ThreadPool::parallelFor(size_t count, size_t grain, const RangeFn &fn)
+    {
+        grain = std::max<size_t>(grain, 1);
+        if (m_workers.empty() || count <= grain)
+        {
+            if (count > 0)
+                fn(0, count);
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_job = &fn;
+            m_count = count;
+            m_grain = grain;
+            m_next.store(0, std::memory_order_relaxed);
+            m_active = static_cast<int>(m_workers.size());
+            m_generation++;
+        }
+        m_wake.notify_all();
+
+        runChunks();
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_done.wait(lock, [this]
+                    { return m_active == 0; });
+        m_job = nullptr;
+    }
+
+    void ThreadPool::runChunks()
+    {
+        while (true)
+        {
+            size_t begin = m_next.fetch_add(m_grain, std::memory_order_relaxed);
+            if (begin >= m_count)
+                break;
+            (*m_job)(begin, std::min(begin + m_grain, m_count));
+        }
+    }
+
+    void ThreadPool::workerLoop(uint64_t seen)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (true)
+        {
+            m_wake.wait(lock, [&]
+                        { return m_quit || m_generation != seen; });
+            if (m_quit)
+                break;
+
+            seen = m_generation;
+            lock.unlock();
+
+            runChunks();
+
+            lock.lock();
+            if (--m_active == 0)
+                m_done.notify_one();
+        }
+    }
+
+} // namespace slingshot
@@ -0,0 +1,66 @@
+#ifndef SLINGSHOT_CORE_THREAD_POOL_HPP
+#define SLINGSHOT_CORE_THREAD_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace slingshot
+{
+
+    // Fixed set of worker threads for data-parallel loops. parallelFor()
+    // splits a range into chunks that the workers and the calling thread claim
+    // from a shared counter until none are left, so a thread that finishes
+    // early picks up the slack of a slow one.
+    //
+    // Without thread support (Emscripten built without -pthread) the pool
+    // stays at one thread and parallelFor() runs inline.
+    class ThreadPool
+    {
+    public:
+        using RangeFn = std::function<void(size_t begin, size_t end)>;
+
+        // `threads` counts the caller, so 1 means no workers
+        explicit ThreadPool(int threads = 1);
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool &) = delete;
+        ThreadPool &operator=(const ThreadPool &) = delete;
+
+        void setThreadCount(int threads);
+        int getThreadCount() const { return static_cast<int>(m_workers.size()) + 1; }
+
+        // Calls fn on disjoint sub-ranges covering [0, count), at most `grain`
+        // items each, and returns once all of them are done
+        void parallelFor(size_t count, size_t grain, const RangeFn &fn);
+
+        // Threads the platform can run at once (1 without thread support)
+        static int hardwareThreads();
+
+    private:
+        void stopWorkers();
+        void workerLoop(uint64_t seen); // Runs jobs after generation `seen`
+        void runChunks();
+
+        std::vector<std::thread> m_workers;
+        std::mutex m_mutex;
+        std::condition_variable m_wake;
+        std::condition_variable m_done;
+
+        const RangeFn *m_job = nullptr;
+        size_t m_count = 0;
+        size_t m_grain = 1;
+        std::atomic<size_t> m_next{0};
+        uint64_t m_generation = 0; // Bumped per parallelFor so workers run each job once
+        int m_active = 0;          // Workers yet to finish the current job
+        bool m_quit = false;
+    };
+
+} // namespace slingshot
+
+#endif
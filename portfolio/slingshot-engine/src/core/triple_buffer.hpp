@@ -0,0 +1,49 @@
+#ifndef SLINGSHOT_CORE_TRIPLE_BUFFER_HPP
+#define SLINGSHOT_CORE_TRIPLE_BUFFER_HPP
+
+#include <atomic>
+#include <cstdint>
+
+namespace slingshot
+{
+
+    // Lock-free single-producer / single-consumer triple buffer. The writer
+    // fills back() and publish()es it; the reader acquire()s the newest
+    // published slot into front(). Neither side ever waits, and the reader
+    // never sees a slot while it is being written.
+    template <typename T>
+    class TripleBuffer
+    {
+    public:
+        // Writer side
+        T &back() { return m_slots[m_back]; }
+
+        void publish()
+        {
+            m_back = m_middle.exchange(static_cast<uint8_t>(m_back | FRESH), std::memory_order_acq_rel) & INDEX;
+        }
+
+        // Reader side: returns true if a newer slot was published since the last call
+        bool acquire()
+        {
+            if (!(m_middle.load(std::memory_order_acquire) & FRESH))
+                return false;
+            m_front = m_middle.exchange(m_front, std::memory_order_acq_rel) & INDEX;
+            return true;
+        }
+
+        const T &front() const { return m_slots[m_front]; }
+
+    private:
+        static constexpr uint8_t INDEX = 0x3;
+        static constexpr uint8_t FRESH = 0x4;
+
+        T m_slots[3];
+        std::atomic<uint8_t> m_middle{1}; // Slot index in the middle, plus FRESH once published
+        uint8_t m_back = 0;               // Writer-owned
+        uint8_t m_front = 2;              // Reader-owned
+    };
+
+} // namespace slingshot
+
+#endif
@@ -5,7 +5,6 @@
 #include "config/physics.hpp"
 #include "config/colors.hpp"
 #include "core/renderer.hpp"
-#include <vector>
 
 namespace slingshot
 {
@@ -13,34 +12,25 @@ namespace slingshot
     class Agent : public Entity
     {
     public:
-        std::vector<Vec2> trail;
+        Trail trail;
 
         Agent(Vec2 position)
+            : Entity(Body(EntityType::Agent, position, false))
         {
-            pos = position;
-            mass = physics::defaults::AGENT_MASS;
-            radius = physics::defaults::AGENT_RADIUS;
-            pinned = false;
         }
 
         void update(float dt) override
         {
-            trail.push_back(pos);
-            if (trail.size() > physics::MAX_TRAIL_POINTS)
-            {
-                trail.erase(trail.begin());
-            }
+            trail.push(getPos());
         }
 
-        void render(Renderer &r) const override
+        // The trail is drawn by PhysicsWorld::render, which may take it from a snapshot
+        void draw(Renderer &r, Vec2 pos) const override
         {
-            r.drawTrail(trail, colors::entity::AGENT_TRAIL);
-            r.fillCircle(pos, radius, colors::entity::AGENT);
-            r.drawCircle(pos, radius, colors::entity::AGENT.withAlpha(200));
+            r.fillCircle(pos, getRadius(), colors::entity::AGENT);
+            r.drawCircle(pos, getRadius(), colors::entity::AGENT.withAlpha(200));
         }
 
-        bool exertsGravity() const override { return false; }
-
         void clearTrail() { trail.clear(); }
     };
 
@@ -13,18 +13,14 @@ namespace slingshot
     {
     public:
         Asteroid(Vec2 position, bool isPinned = true, std::string entityId = "")
+            : Entity(Body(EntityType::Asteroid, position, isPinned, entityId))
         {
-            pos = position;
-            mass = physics::defaults::ASTEROID_MASS;
-            radius = physics::defaults::ASTEROID_RADIUS;
-            pinned = isPinned;
-            id = entityId;
         }
 
-        void render(Renderer &r) const override
+        void draw(Renderer &r, Vec2 pos) const override
         {
-            r.fillCircle(pos, radius, colors::entity::ASTEROID_FILL);
-            r.drawCircle(pos, radius, colors::entity::ASTEROID_STROKE);
+            r.fillCircle(pos, getRadius(), colors::entity::ASTEROID_FILL);
+            r.drawCircle(pos, getRadius(), colors::entity::ASTEROID_STROKE);
         }
     };
 
@@ -2,6 +2,8 @@
 #define SLINGSHOT_ENTITIES_ENTITY_HPP
 
 #include "math/vec2.hpp"
+#include "physics/body.hpp"
+#include "physics/body_store.hpp"
 #include <string>
 #include <vector>
 
@@ -10,35 +12,79 @@ namespace slingshot
 
     class Renderer;
 
+    // Render/behaviour view over a body. Until the entity is added to a
+    // PhysicsWorld it owns its initial state; afterwards every accessor reads
+    // and writes the world's BodyStore at the bound index.
     class Entity
     {
     public:
-        Vec2 pos;
-        Vec2 vel;
-        float mass = 0.0f;
-        float radius = 0.0f;
-        bool pinned = true;
-        std::string id;
-        std::string orbitsId;
-
         virtual ~Entity() = default;
 
-        virtual void render(Renderer &renderer) const = 0;
+        // Draws the entity as if it were at `pos` (e.g. an interpolated position)
+        virtual void draw(Renderer &renderer, Vec2 pos) const = 0;
+        void render(Renderer &renderer) const { draw(renderer, getPos()); }
+
         virtual void update(float dt) {}
 
-        virtual bool exertsGravity() const { return mass > 0.0f; }
-        virtual bool isAffectedByGravity() const { return !pinned; }
+        EntityType getType() const { return m_body.type; }
+        const std::string &getId() const { return m_body.id; }
+        const std::string &getOrbitsId() const { return m_body.orbitsId; }
+        void setOrbitsId(const std::string &id) { m_body.orbitsId = id; }
+
+        Vec2 getPos() const { return m_store ? m_store->getPos(m_index) : m_body.pos; }
+        Vec2 getVel() const { return m_store ? m_store->getVel(m_index) : m_body.vel; }
+        float getMass() const { return m_store ? m_store->mass()[m_index] : m_body.mass; }
+        float getRadius() const { return m_store ? m_store->radius()[m_index] : m_body.radius; }
+        bool isPinned() const { return m_body.pinned; }
+
+        void setPos(Vec2 p)
+        {
+            if (m_store)
+                m_store->setPos(m_index, p);
+            else
+                m_body.pos = p;
+        }
+
+        void setVel(Vec2 v)
+        {
+            if (m_store)
+                m_store->setVel(m_index, v);
+            else
+                m_body.vel = v;
+        }
+
+        bool exertsGravity() const { return m_body.exertsGravity(); }
+        bool isAffectedByGravity() const { return m_body.isAffectedByGravity(); }
 
         bool collidesWith(const Entity &other) const
         {
-            float dist = pos.distanceTo(other.pos);
-            return dist < radius + other.radius;
+            float minDist = getRadius() + other.getRadius();
+            return getPos().distanceSquaredTo(other.getPos()) < minDist * minDist;
         }
 
         bool contains(Vec2 point) const
         {
-            return pos.distanceTo(point) < radius;
+            return getPos().distanceSquaredTo(point) < getRadius() * getRadius();
+        }
+
+        // Index into the owning world's BodyStore (only meaningful once added)
+        size_t getIndex() const { return m_index; }
+
+    protected:
+        explicit Entity(const Body &body) : m_body(body) {}
+
+    private:
+        friend class PhysicsWorld;
+
+        void bind(BodyStore *store, size_t index)
+        {
+            m_store = store;
+            m_index = index;
         }
+
+        Body m_body;
+        BodyStore *m_store = nullptr;
+        size_t m_index = 0;
     };
 
 } // namespace slingshot
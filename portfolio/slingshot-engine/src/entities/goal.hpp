@@ -13,22 +13,16 @@ namespace slingshot
     {
     public:
         Goal(Vec2 position)
+            : Entity(Body(EntityType::Goal, position, true))
         {
-            pos = position;
-            mass = 0.0f;
-            radius = physics::defaults::GOAL_RADIUS;
-            pinned = true;
         }
 
-        void render(Renderer &r) const override
+        void draw(Renderer &r, Vec2 pos) const override
         {
-            r.fillCircle(pos, radius, colors::entity::GOAL_FILL);
-            r.drawCircle(pos, radius, colors::entity::GOAL_RING);
-            r.drawCircle(pos, radius * 0.7f, colors::entity::GOAL_RING.withAlpha(100));
+            r.fillCircle(pos, getRadius(), colors::entity::GOAL_FILL);
+            r.drawCircle(pos, getRadius(), colors::entity::GOAL_RING);
+            r.drawCircle(pos, getRadius() * 0.7f, colors::entity::GOAL_RING.withAlpha(100));
         }
-
-        bool exertsGravity() const override { return false; }
-        bool isAffectedByGravity() const override { return false; }
     };
 
 } // namespace slingshot
@@ -13,18 +13,14 @@ namespace slingshot
     {
     public:
         Planet(Vec2 position, bool isPinned = true, std::string entityId = "")
+            : Entity(Body(EntityType::Planet, position, isPinned, entityId))
         {
-            pos = position;
-            mass = physics::defaults::PLANET_MASS;
-            radius = physics::defaults::PLANET_RADIUS;
-            pinned = isPinned;
-            id = entityId;
         }
 
-        void render(Renderer &r) const override
+        void draw(Renderer &r, Vec2 pos) const override
         {
-            r.fillCircle(pos, radius, colors::entity::PLANET_FILL);
-            r.drawGlow(pos, radius, radius + 12.0f, colors::entity::PLANET_GLOW);
+            r.fillCircle(pos, getRadius(), colors::entity::PLANET_FILL);
+            r.drawGlow(pos, getRadius(), getRadius() + 12.0f, colors::entity::PLANET_GLOW);
         }
     };
 
@@ -13,23 +13,19 @@ namespace slingshot
     {
     public:
         Singularity(Vec2 position, bool isPinned = true, std::string entityId = "")
+            : Entity(Body(EntityType::Singularity, position, isPinned, entityId))
         {
-            pos = position;
-            mass = physics::defaults::SINGULARITY_MASS;
-            radius = physics::defaults::SINGULARITY_RADIUS;
-            pinned = isPinned;
-            id = entityId;
         }
 
-        void render(Renderer &r) const override
+        void draw(Renderer &r, Vec2 pos) const override
         {
             // Dark center (event horizon)
-            r.fillCircle(pos, radius, colors::entity::SINGULARITY_CENTER);
+            r.fillCircle(pos, getRadius(), colors::entity::SINGULARITY_CENTER);
             // Accretion disk - inner bright ring
-            r.drawCircle(pos, radius + 3.0f, colors::entity::SINGULARITY_DISK_INNER);
+            r.drawCircle(pos, getRadius() + 3.0f, colors::entity::SINGULARITY_DISK_INNER);
             // Accretion disk - glowing layers
-            r.drawGlow(pos, radius + 5.0f, radius + 20.0f, colors::entity::SINGULARITY_DISK_INNER);
-            r.drawGlow(pos, radius + 20.0f, radius + 40.0f, colors::entity::SINGULARITY_DISK_OUTER);
+            r.drawGlow(pos, getRadius() + 5.0f, getRadius() + 20.0f, colors::entity::SINGULARITY_DISK_INNER);
+            r.drawGlow(pos, getRadius() + 20.0f, getRadius() + 40.0f, colors::entity::SINGULARITY_DISK_OUTER);
         }
     };
 
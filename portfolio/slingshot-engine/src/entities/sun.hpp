@@ -13,18 +13,14 @@ namespace slingshot
     {
     public:
         Sun(Vec2 position, bool isPinned = true, std::string entityId = "")
+            : Entity(Body(EntityType::Sun, position, isPinned, entityId))
         {
-            pos = position;
-            mass = physics::defaults::SUN_MASS;
-            radius = physics::defaults::SUN_RADIUS;
-            pinned = isPinned;
-            id = entityId;
         }
 
-        void render(Renderer &r) const override
+        void draw(Renderer &r, Vec2 pos) const override
         {
-            r.fillCircle(pos, radius, colors::entity::SUN_CORE);
-            r.drawGlow(pos, radius, radius + 25.0f, colors::entity::SUN_GLOW);
+            r.fillCircle(pos, getRadius(), colors::entity::SUN_CORE);
+            r.drawGlow(pos, getRadius(), getRadius() + 25.0f, colors::entity::SUN_GLOW);
         }
     };
 
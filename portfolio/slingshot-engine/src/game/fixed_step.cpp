@@ -0,0 +1,59 @@
+#include "game/fixed_step.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace slingshot
+{
+
+    namespace
+    {
+        // Frame times this close to a whole number of steps are treated as exact,
+        // so timer jitter on a display running at the step rate cannot make
+        // frames alternate between zero and two steps
+        constexpr double SNAP_SECONDS = 0.0005;
+    }
+
+    FixedStepClock::FixedStepClock(double stepSeconds, int maxStepsPerFrame)
+        : m_step(stepSeconds), m_maxSteps(maxStepsPerFrame)
+    {
+    }
+
+    int FixedStepClock::advance(double frameSeconds)
+    {
+        m_stats.frameSeconds = frameSeconds;
+
+        // Negative deltas (clock hiccups) count as zero
+        double elapsed = std::max(frameSeconds, 0.0);
+        double whole = std::round(elapsed / m_step) * m_step;
+        if (whole > 0.0 && std::fabs(elapsed - whole) < SNAP_SECONDS)
+        {
+            elapsed = whole;
+        }
+        m_accumulator += elapsed;
+
+        int steps = static_cast<int>(m_accumulator / m_step);
+        if (steps > m_maxSteps)
+        {
+            // Too far behind (slow device or a backgrounded tab): run the cap and
+            // drop the rest rather than spiralling into ever longer frames
+            m_stats.droppedSteps += static_cast<uint64_t>(steps - m_maxSteps);
+            steps = m_maxSteps;
+            m_accumulator = 0.0;
+        }
+        else
+        {
+            m_accumulator -= steps * m_step;
+        }
+
+        m_stats.steps = steps;
+        m_stats.totalSteps += static_cast<uint64_t>(steps);
+        return steps;
+    }
+
+    void FixedStepClock::reset()
+    {
+        m_accumulator = 0.0;
+        m_stats = FrameStats();
+    }
+
+} // namespace slingshot
@@ -0,0 +1,41 @@
+#ifndef SLINGSHOT_GAME_FIXED_STEP_HPP
+#define SLINGSHOT_GAME_FIXED_STEP_HPP
+
+#include <cstdint>
+
+namespace slingshot
+{
+
+    struct FrameStats
+    {
+        double frameSeconds = 0.0;  // Wall time since the previous frame (unclamped)
+        int steps = 0;              // Physics steps run this frame
+        uint64_t totalSteps = 0;
+        uint64_t droppedSteps = 0;  // Steps discarded by the per-frame cap
+    };
+
+    // Accumulator for running physics at a fixed rate independent of the
+    // display refresh rate. Each frame, advance() returns how many fixed
+    // steps are due; getAlpha() is how far the render time sits between the
+    // last two steps, for interpolating positions.
+    class FixedStepClock
+    {
+    public:
+        explicit FixedStepClock(double stepSeconds, int maxStepsPerFrame);
+
+        int advance(double frameSeconds);
+        void reset();
+
+        float getAlpha() const { return static_cast<float>(m_accumulator / m_step); }
+        const FrameStats &getStats() const { return m_stats; }
+
+    private:
+        double m_step;
+        int m_maxSteps;
+        double m_accumulator = 0.0;
+        FrameStats m_stats;
+    };
+
+} // namespace slingshot
+
+#endif
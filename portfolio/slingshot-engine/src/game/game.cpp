@@ -12,6 +12,14 @@ namespace slingshot
         }
     }
 
+    void Game::restoreProgress(const GameProgress &progress)
+    {
+        m_state = progress.state;
+        m_levelId = progress.levelId;
+        m_attempts = progress.attempts;
+        m_loseReason = progress.loseReason;
+    }
+
     void Game::triggerWin()
     {
         setState(GameState::Won);
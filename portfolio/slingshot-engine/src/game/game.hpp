@@ -22,6 +22,15 @@ namespace slingshot
         OutOfBounds
     };
 
+    // Plain copy of the game's progress, for checkpoints
+    struct GameProgress
+    {
+        GameState state = GameState::Rules;
+        int levelId = 1;
+        int attempts = 0;
+        LoseReason loseReason = LoseReason::None;
+    };
+
     class Game
     {
     public:
@@ -48,6 +57,10 @@ namespace slingshot
         void triggerWin();
         void triggerLose(LoseReason reason);
 
+        // Restoring does not fire any callbacks
+        GameProgress getProgress() const { return {m_state, m_levelId, m_attempts, m_loseReason}; }
+        void restoreProgress(const GameProgress &progress);
+
     private:
         GameState m_state = GameState::Rules;
         int m_levelId = 1;
@@ -0,0 +1,272 @@
+#include "game/level_binary.hpp"
+#include "core/byte_io.hpp"
+#include "physics/world.hpp"
+#include "entities/goal.hpp"
+#include <cstring>
+#include <fstream>
+#include <unordered_map>
+
+namespace slingshot
+{
+
+    namespace level_binary
+    {
+        using namespace byte_io;
+
+        namespace
+        {
+            constexpr char MAGIC[4] = {'S', 'L', 'V', 'L'};
+
+            constexpr uint16_t FLAG_TUTORIAL = 1;
+            constexpr uint16_t FLAG_HAS_GOAL = 2;
+            constexpr uint8_t ENTITY_PINNED = 1;
+
+            // Header field offsets
+            constexpr size_t VERSION_AT = 4;
+            constexpr size_t FLAGS_AT = 6;
+            constexpr size_t ID_AT = 8;
+            constexpr size_t ENTITY_COUNT_AT = 12;
+            constexpr size_t STRING_BYTES_AT = 16;
+            constexpr size_t NAME_AT = 20;
+            constexpr size_t SPAWN_AT = 24;
+            constexpr size_t GOAL_AT = 32;
+
+            // Entity record field offsets
+            constexpr size_t TYPE_AT = 0;
+            constexpr size_t ENTITY_FLAGS_AT = 1;
+            constexpr size_t POS_AT = 4;
+            constexpr size_t ENTITY_ID_AT = 12;
+            constexpr size_t ORBITS_AT = 16;
+
+            bool isPlaceable(uint8_t type)
+            {
+                return level::entityTypeName(static_cast<EntityType>(type))[0] != '\0';
+            }
+
+            // Builds the string table, storing each distinct string once
+            class StringTable
+            {
+            public:
+                StringTable() { m_bytes.push_back('\0'); }
+
+                uint32_t add(const std::string &value)
+                {
+                    if (value.empty())
+                        return 0;
+
+                    auto found = m_offsets.find(value);
+                    if (found != m_offsets.end())
+                        return found->second;
+
+                    uint32_t offset = static_cast<uint32_t>(m_bytes.size());
+                    m_bytes.insert(m_bytes.end(), value.begin(), value.end());
+                    m_bytes.push_back('\0');
+                    m_offsets.emplace(value, offset);
+                    return offset;
+                }
+
+                const std::vector<uint8_t> &getBytes() const { return m_bytes; }
+
+            private:
+                std::vector<uint8_t> m_bytes;
+                std::unordered_map<std::string, uint32_t> m_offsets;
+            };
+        }
+
+        bool LevelView::open(const uint8_t *data, size_t size)
+        {
+            m_data = nullptr;
+            if (size < HEADER_SIZE || std::memcmp(data, MAGIC, sizeof(MAGIC)) != 0 ||
+                readU16(data + VERSION_AT) != VERSION)
+                return false;
+
+            uint64_t entityCount = readU32(data + ENTITY_COUNT_AT);
+            uint64_t stringBytes = readU32(data + STRING_BYTES_AT);
+            if (stringBytes == 0 || size != HEADER_SIZE + entityCount * ENTITY_SIZE + stringBytes)
+                return false;
+
+            // Every string must end inside the table, which the final NUL guarantees
+            const uint8_t *strings = data + HEADER_SIZE + entityCount * ENTITY_SIZE;
+            if (strings[stringBytes - 1] != '\0' || readU32(data + NAME_AT) >= stringBytes)
+                return false;
+
+            for (uint64_t i = 0; i < entityCount; i++)
+            {
+                const uint8_t *record = data + HEADER_SIZE + i * ENTITY_SIZE;
+                if (!isPlaceable(record[TYPE_AT]) ||
+                    readU32(record + ENTITY_ID_AT) >= stringBytes ||
+                    readU32(record + ORBITS_AT) >= stringBytes)
+                    return false;
+            }
+
+            m_data = data;
+            m_strings = strings;
+            m_entityCount = static_cast<uint32_t>(entityCount);
+            return true;
+        }
+
+        int LevelView::getId() const
+        {
+            return static_cast<int>(static_cast<int32_t>(readU32(m_data + ID_AT)));
+        }
+
+        const char *LevelView::getName() const
+        {
+            return string(readU32(m_data + NAME_AT));
+        }
+
+        bool LevelView::isTutorial() const
+        {
+            return readU16(m_data + FLAGS_AT) & FLAG_TUTORIAL;
+        }
+
+        bool LevelView::hasGoal() const
+        {
+            return readU16(m_data + FLAGS_AT) & FLAG_HAS_GOAL;
+        }
+
+        Vec2 LevelView::getSpawn() const
+        {
+            return readVec2(m_data + SPAWN_AT);
+        }
+
+        Vec2 LevelView::getGoal() const
+        {
+            return readVec2(m_data + GOAL_AT);
+        }
+
+        EntityRecord LevelView::getEntity(uint32_t index) const
+        {
+            const uint8_t *record = m_data + HEADER_SIZE + size_t(index) * ENTITY_SIZE;
+            return {static_cast<EntityType>(record[TYPE_AT]),
+                    readVec2(record + POS_AT),
+                    (record[ENTITY_FLAGS_AT] & ENTITY_PINNED) != 0,
+                    string(readU32(record + ENTITY_ID_AT)),
+                    string(readU32(record + ORBITS_AT))};
+        }
+
+        const char *LevelView::string(uint32_t offset) const
+        {
+            return reinterpret_cast<const char *>(m_strings + offset);
+        }
+
+        void encode(const LevelDefinition &level, std::vector<uint8_t> &out)
+        {
+            StringTable strings;
+            uint32_t name = strings.add(level.info.name);
+
+            out.clear();
+            out.reserve(HEADER_SIZE + level.entities.size() * ENTITY_SIZE);
+            for (char c : MAGIC)
+                out.push_back(static_cast<uint8_t>(c));
+            writeU16(out, VERSION);
+            writeU16(out, static_cast<uint16_t>((level.info.tutorial ? FLAG_TUTORIAL : 0) |
+                                                (level.hasGoal ? FLAG_HAS_GOAL : 0)));
+            writeU32(out, static_cast<uint32_t>(level.info.id));
+            writeU32(out, static_cast<uint32_t>(level.entities.size()));
+            size_t stringBytesAt = out.size();
+            writeU32(out, 0); // String table size, patched below
+            writeU32(out, name);
+            writeVec2(out, level.info.spawn);
+            writeVec2(out, level.info.goal);
+
+            for (const auto &entity : level.entities)
+            {
+                out.push_back(static_cast<uint8_t>(entity.type));
+                out.push_back(entity.pinned ? ENTITY_PINNED : 0);
+                writeU16(out, 0);
+                writeVec2(out, entity.pos);
+                writeU32(out, strings.add(entity.id));
+                writeU32(out, strings.add(entity.orbits));
+            }
+
+            const auto &table = strings.getBytes();
+            out.insert(out.end(), table.begin(), table.end());
+
+            patchU32(out, stringBytesAt, static_cast<uint32_t>(table.size()));
+        }
+
+        bool decode(const uint8_t *data, size_t size, LevelDefinition &level)
+        {
+            LevelView view;
+            if (!view.open(data, size))
+                return false;
+
+            level = LevelDefinition();
+            level.info.id = view.getId();
+            level.info.name = view.getName();
+            level.info.tutorial = view.isTutorial();
+            level.info.spawn = view.getSpawn();
+            level.info.goal = view.getGoal();
+            level.hasGoal = view.hasGoal();
+
+            level.entities.resize(view.getEntityCount());
+            for (uint32_t i = 0; i < view.getEntityCount(); i++)
+            {
+                EntityRecord record = view.getEntity(i);
+                EntityDefinition &entity = level.entities[i];
+                entity.type = record.type;
+                entity.pos = record.pos;
+                entity.pinned = record.pinned;
+                entity.id = record.id;
+                entity.orbits = record.orbits;
+            }
+            return true;
+        }
+
+        bool readFile(const std::string &path, std::vector<uint8_t> &out)
+        {
+            std::ifstream file(path, std::ios::binary | std::ios::ate);
+            if (!file.is_open())
+                return false;
+
+            std::streamoff size = file.tellg();
+            if (size < 0)
+                return false;
+
+            out.resize(static_cast<size_t>(size));
+            file.seekg(0);
+            return static_cast<bool>(file.read(reinterpret_cast<char *>(out.data()), size));
+        }
+
+        bool load(const uint8_t *data, size_t size, PhysicsWorld &world, LevelData &info)
+        {
+            LevelView view;
+            if (!view.open(data, size))
+                return false;
+
+            if (view.hasGoal())
+            {
+                world.addEntity(std::make_unique<Goal>(view.getGoal()));
+            }
+
+            // Entities are created straight from the records
+            EntityDefinition entity;
+            for (uint32_t i = 0; i < view.getEntityCount(); i++)
+            {
+                EntityRecord record = view.getEntity(i);
+                entity.type = record.type;
+                entity.pos = record.pos;
+                entity.pinned = record.pinned;
+                entity.id = record.id;
+                entity.orbits = record.orbits;
+                world.addEntity(level::createEntity(entity));
+            }
+            world.initializeOrbits();
+
+            info.id = view.getId();
+            info.name = view.getName();
+            info.tutorial = view.isTutorial();
+            info.spawn = view.getSpawn();
+            info.goal = view.getGoal();
+            return true;
+        }
+
+        bool load(const std::string &path, PhysicsWorld &world, LevelData &info)
+        {
+            std::vector<uint8_t> bytes;
+            return readFile(path, bytes) && load(bytes.data(), bytes.size(), world, info);
+        }
+    }
+
+} // namespace slingshot
@@ -0,0 +1,88 @@
+#ifndef SLINGSHOT_GAME_LEVEL_BINARY_HPP
+#define SLINGSHOT_GAME_LEVEL_BINARY_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "math/vec2.hpp"
+#include "game/level_definition.hpp"
+
+namespace slingshot
+{
+
+    class PhysicsWorld;
+
+    // Compiled level format written by slingshot_levelc. Little-endian:
+    //
+    //   Header, 40 bytes
+    //     0  char[4]  magic "SLVL"
+    //     4  u16      format version
+    //     6  u16      flags (1 = tutorial, 2 = has goal)
+    //     8  i32      level id
+    //     12 u32      entity count
+    //     16 u32      string table size in bytes
+    //     20 u32      name (string offset)
+    //     24 f32 x 4  spawn x, y, goal x, y
+    //   Entity records, 20 bytes each
+    //     0  u8       EntityType
+    //     1  u8       flags (1 = pinned)
+    //     2  u16      reserved, 0
+    //     4  f32 x 2  position
+    //     12 u32      id (string offset)
+    //     16 u32      orbits (string offset)
+    //   String table: NUL-terminated strings, offset 0 is the empty string
+    namespace level_binary
+    {
+        constexpr uint16_t VERSION = 1;
+        constexpr size_t HEADER_SIZE = 40;
+        constexpr size_t ENTITY_SIZE = 20;
+        constexpr const char *FILE_EXTENSION = ".lvl";
+
+        struct EntityRecord
+        {
+            EntityType type;
+            Vec2 pos;
+            bool pinned;
+            const char *id;     // Points into the blob
+            const char *orbits; // Points into the blob
+        };
+
+        // Read-only view over a compiled level in memory. open() validates the
+        // whole blob once; the accessors then read fields in place.
+        class LevelView
+        {
+        public:
+            bool open(const uint8_t *data, size_t size);
+
+            int getId() const;
+            const char *getName() const;
+            bool isTutorial() const;
+            bool hasGoal() const;
+            Vec2 getSpawn() const;
+            Vec2 getGoal() const;
+
+            uint32_t getEntityCount() const { return m_entityCount; }
+            EntityRecord getEntity(uint32_t index) const;
+
+        private:
+            const char *string(uint32_t offset) const;
+
+            const uint8_t *m_data = nullptr;
+            const uint8_t *m_strings = nullptr;
+            uint32_t m_entityCount = 0;
+        };
+
+        void encode(const LevelDefinition &level, std::vector<uint8_t> &out);
+        bool decode(const uint8_t *data, size_t size, LevelDefinition &level);
+
+        bool readFile(const std::string &path, std::vector<uint8_t> &out);
+
+        // Same contract as LevelLoader::load, without going through JSON
+        bool load(const uint8_t *data, size_t size, PhysicsWorld &world, LevelData &info);
+        bool load(const std::string &path, PhysicsWorld &world, LevelData &info);
+    }
+
+} // namespace slingshot
+
+#endif
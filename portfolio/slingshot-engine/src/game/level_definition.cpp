@@ -0,0 +1,117 @@
+#include "game/level_definition.hpp"
+#include "physics/world.hpp"
+#include "entities/planet.hpp"
+#include "entities/sun.hpp"
+#include "entities/singularity.hpp"
+#include "entities/asteroid.hpp"
+#include "entities/goal.hpp"
+
+namespace slingshot
+{
+
+    namespace
+    {
+        struct TypeName
+        {
+            EntityType type;
+            const char *name;
+        };
+
+        constexpr TypeName PLACEABLE_TYPES[] = {
+            {EntityType::Planet, "planet"},
+            {EntityType::Sun, "sun"},
+            {EntityType::Singularity, "singularity"},
+            {EntityType::Asteroid, "asteroid"}};
+    }
+
+    bool EntityDefinition::operator==(const EntityDefinition &other) const
+    {
+        return type == other.type && pos.x == other.pos.x && pos.y == other.pos.y &&
+               pinned == other.pinned && id == other.id && orbits == other.orbits;
+    }
+
+    bool LevelDefinition::operator==(const LevelDefinition &other) const
+    {
+        return info.id == other.info.id && info.name == other.info.name &&
+               info.tutorial == other.info.tutorial &&
+               info.spawn.x == other.info.spawn.x && info.spawn.y == other.info.spawn.y &&
+               hasGoal == other.hasGoal &&
+               info.goal.x == other.info.goal.x && info.goal.y == other.info.goal.y &&
+               entities == other.entities;
+    }
+
+    void LevelDefinition::build(PhysicsWorld &world) const
+    {
+        if (hasGoal)
+        {
+            world.addEntity(std::make_unique<Goal>(info.goal));
+        }
+
+        for (const auto &definition : entities)
+        {
+            auto entity = level::createEntity(definition);
+            if (entity)
+            {
+                world.addEntity(std::move(entity));
+            }
+        }
+
+        world.initializeOrbits();
+    }
+
+    namespace level
+    {
+        bool entityTypeFromName(const std::string &name, EntityType &type)
+        {
+            for (const auto &entry : PLACEABLE_TYPES)
+            {
+                if (name == entry.name)
+                {
+                    type = entry.type;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        const char *entityTypeName(EntityType type)
+        {
+            for (const auto &entry : PLACEABLE_TYPES)
+            {
+                if (entry.type == type)
+                    return entry.name;
+            }
+            return "";
+        }
+
+        std::unique_ptr<Entity> createEntity(const EntityDefinition &definition)
+        {
+            std::unique_ptr<Entity> entity;
+            switch (definition.type)
+            {
+            case EntityType::Planet:
+                entity = std::make_unique<Planet>(definition.pos, definition.pinned, definition.id);
+                break;
+            case EntityType::Sun:
+                entity = std::make_unique<Sun>(definition.pos, definition.pinned, definition.id);
+                break;
+            case EntityType::Singularity:
+                entity = std::make_unique<Singularity>(definition.pos, definition.pinned, definition.id);
+                break;
+            case EntityType::Asteroid:
+                entity = std::make_unique<Asteroid>(definition.pos, definition.pinned, definition.id);
+                break;
+            case EntityType::Agent:
+            case EntityType::Goal:
+                break;
+            }
+
+            if (entity && !definition.orbits.empty())
+            {
+                entity->setOrbitsId(definition.orbits);
+            }
+            return entity;
+        }
+    }
+
+} // namespace slingshot
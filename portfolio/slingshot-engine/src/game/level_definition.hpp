@@ -0,0 +1,63 @@
+#ifndef SLINGSHOT_GAME_LEVEL_DEFINITION_HPP
+#define SLINGSHOT_GAME_LEVEL_DEFINITION_HPP
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "math/vec2.hpp"
+#include "physics/body.hpp"
+
+namespace slingshot
+{
+
+    class Entity;
+    class PhysicsWorld;
+
+    struct LevelData
+    {
+        int id = 0;
+        std::string name;
+        bool tutorial = false;
+        Vec2 spawn;
+        Vec2 goal;
+    };
+
+    // One placed body, as authored
+    struct EntityDefinition
+    {
+        EntityType type = EntityType::Planet;
+        Vec2 pos;
+        bool pinned = true;
+        std::string id;
+        std::string orbits;
+
+        bool operator==(const EntityDefinition &other) const;
+    };
+
+    // A level independent of its storage format. The JSON and binary loaders
+    // both produce one; build() turns it into world entities.
+    struct LevelDefinition
+    {
+        LevelData info;
+        bool hasGoal = false;
+        std::vector<EntityDefinition> entities;
+
+        bool operator==(const LevelDefinition &other) const;
+        bool operator!=(const LevelDefinition &other) const { return !(*this == other); }
+
+        // Adds the goal and entities to `world` and sets up orbits
+        void build(PhysicsWorld &world) const;
+    };
+
+    namespace level
+    {
+        // Placeable entity types by their authored name ("planet", "sun", ...)
+        bool entityTypeFromName(const std::string &name, EntityType &type);
+        const char *entityTypeName(EntityType type);
+
+        std::unique_ptr<Entity> createEntity(const EntityDefinition &definition);
+    }
+
+} // namespace slingshot
+
+#endif
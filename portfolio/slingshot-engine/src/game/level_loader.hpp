@@ -4,34 +4,60 @@
 #include "lib/json.hpp"
 #include "math/vec2.hpp"
 #include "physics/world.hpp"
-#include "entities/planet.hpp"
-#include "entities/sun.hpp"
-#include "entities/singularity.hpp"
-#include "entities/asteroid.hpp"
-#include "entities/goal.hpp"
+#include "game/level_definition.hpp"
 
+#include <cstdio>
 #include <fstream>
 #include <string>
-#include <memory>
+#include <vector>
 
 namespace slingshot
 {
 
     using json = nlohmann::json;
 
-    struct LevelData
-    {
-        int id = 0;
-        std::string name;
-        bool tutorial = false;
-        Vec2 spawn;
-        Vec2 goal;
-    };
-
+    // Loads the JSON authoring format. Shipped builds can load levels
+    // compiled by slingshot_levelc instead (see level_binary.hpp).
     class LevelLoader
     {
     public:
+        static constexpr int MAX_LEVELS = 100;
+
+        // <dir>/level_NN.json, the naming the shipped levels use
+        static std::string path(const std::string &dir, int id)
+        {
+            char file[32];
+            std::snprintf(file, sizeof(file), "/level_%02d.json", id);
+            return dir + file;
+        }
+
+        // Reads level_01.json, level_02.json, ... from dir up to the first
+        // one that is missing or unreadable
+        static void readAll(const std::string &dir, std::vector<LevelDefinition> &levels)
+        {
+            for (int id = 1; id <= MAX_LEVELS; ++id)
+            {
+                LevelDefinition level;
+                if (!read(path(dir, id), level))
+                    break;
+                levels.push_back(std::move(level));
+            }
+        }
+
         static bool load(const std::string &path, PhysicsWorld &world, LevelData &data)
+        {
+            LevelDefinition level;
+            if (!read(path, level))
+            {
+                return false;
+            }
+
+            level.build(world);
+            data = level.info;
+            return true;
+        }
+
+        static bool read(const std::string &path, LevelDefinition &level)
         {
             std::ifstream file(path);
             if (!file.is_open())
@@ -49,79 +75,56 @@ namespace slingshot
                 return false;
             }
 
-            data.id = j.value("id", 0);
-            data.name = j.value("name", "");
-            data.tutorial = j.value("tutorial", false);
+            parse(j, level);
+            return true;
+        }
+
+        static void parse(const json &j, LevelDefinition &level)
+        {
+            level = LevelDefinition();
+            level.info.id = j.value("id", 0);
+            level.info.name = j.value("name", "");
+            level.info.tutorial = j.value("tutorial", false);
 
             if (j.contains("spawn") && j["spawn"].is_array() && j["spawn"].size() >= 2)
             {
-                data.spawn = Vec2(j["spawn"][0].get<float>(), j["spawn"][1].get<float>());
+                level.info.spawn = Vec2(j["spawn"][0].get<float>(), j["spawn"][1].get<float>());
             }
 
             if (j.contains("goal") && j["goal"].is_array() && j["goal"].size() >= 2)
             {
-                data.goal = Vec2(j["goal"][0].get<float>(), j["goal"][1].get<float>());
-                world.addEntity(std::make_unique<Goal>(data.goal));
+                level.info.goal = Vec2(j["goal"][0].get<float>(), j["goal"][1].get<float>());
+                level.hasGoal = true;
             }
 
             if (j.contains("entities") && j["entities"].is_array())
             {
                 for (const auto &ent : j["entities"])
                 {
-                    auto entity = createEntity(ent);
-                    if (entity)
+                    EntityDefinition entity;
+                    if (parseEntity(ent, entity))
                     {
-                        world.addEntity(std::move(entity));
+                        level.entities.push_back(std::move(entity));
                     }
                 }
             }
-
-            world.initializeOrbits();
-            return true;
         }
 
     private:
-        static std::unique_ptr<Entity> createEntity(const json &j)
+        static bool parseEntity(const json &j, EntityDefinition &entity)
         {
-            std::string type = j.value("type", "");
-            if (type.empty())
-                return nullptr;
+            if (!level::entityTypeFromName(j.value("type", ""), entity.type))
+                return false;
 
-            Vec2 pos(0, 0);
             if (j.contains("pos") && j["pos"].is_array() && j["pos"].size() >= 2)
             {
-                pos = Vec2(j["pos"][0].get<float>(), j["pos"][1].get<float>());
+                entity.pos = Vec2(j["pos"][0].get<float>(), j["pos"][1].get<float>());
             }
 
-            bool pinned = j.value("pinned", true);
-            std::string id = j.value("id", "");
-            std::string orbits = j.value("orbits", "");
-
-            std::unique_ptr<Entity> entity;
-
-            if (type == "planet")
-            {
-                entity = std::make_unique<Planet>(pos, pinned, id);
-            }
-            else if (type == "sun")
-            {
-                entity = std::make_unique<Sun>(pos, pinned, id);
-            }
-            else if (type == "singularity")
-            {
-                entity = std::make_unique<Singularity>(pos, pinned, id);
-            }
-            else if (type == "asteroid")
-            {
-                entity = std::make_unique<Asteroid>(pos, pinned, id);
-            }
-
-            if (entity && !orbits.empty())
-            {
-                entity->orbitsId = orbits;
-            }
-
-            return entity;
+            entity.pinned = j.value("pinned", true);
+            entity.id = j.value("id", "");
+            entity.orbits = j.value("orbits", "");
+            return true;
         }
     };
 
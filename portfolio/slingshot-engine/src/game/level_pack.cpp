@@ -0,0 +1,155 @@
+#include "game/level_pack.hpp"
+#include "game/level_binary.hpp"
+#include "core/byte_io.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace slingshot
+{
+
+    namespace
+    {
+        constexpr char MAGIC[4] = {'S', 'L', 'P', 'K'};
+        constexpr size_t HEADER_SIZE = 12;
+        constexpr size_t INDEX_ENTRY_SIZE = 12;
+    }
+
+    bool LevelPack::open(const std::string &path)
+    {
+        std::vector<uint8_t> bytes;
+        return level_binary::readFile(path, bytes) && open(std::move(bytes));
+    }
+
+    bool LevelPack::open(std::vector<uint8_t> bytes)
+    {
+        using namespace byte_io;
+        clear();
+
+        if (bytes.size() < HEADER_SIZE || std::memcmp(bytes.data(), MAGIC, sizeof(MAGIC)) != 0 ||
+            readU16(bytes.data() + 4) != VERSION)
+            return false;
+
+        uint64_t count = readU32(bytes.data() + 8);
+        if (bytes.size() < HEADER_SIZE + count * INDEX_ENTRY_SIZE)
+            return false;
+
+        m_bytes = std::move(bytes);
+        for (uint64_t i = 0; i < count; i++)
+        {
+            const uint8_t *entry = m_bytes.data() + HEADER_SIZE + i * INDEX_ENTRY_SIZE;
+            int id = static_cast<int32_t>(readU32(entry));
+            uint64_t offset = readU32(entry + 4);
+            uint64_t size = readU32(entry + 8);
+
+            // Blobs are only validated when decoded, but must lie inside the file
+            if (offset + size > m_bytes.size() || contains(id))
+            {
+                clear();
+                return false;
+            }
+            index({id, static_cast<uint32_t>(offset), static_cast<uint32_t>(size), nullptr});
+        }
+        return true;
+    }
+
+    void LevelPack::add(LevelDefinition level)
+    {
+        int id = level.info.id;
+        if (contains(id))
+        {
+            m_entries[m_slotById[id]].parsed = std::make_unique<LevelDefinition>(std::move(level));
+            return;
+        }
+        index({id, 0, 0, std::make_unique<LevelDefinition>(std::move(level))});
+    }
+
+    void LevelPack::clear()
+    {
+        m_bytes.clear();
+        m_entries.clear();
+        m_slotById.clear();
+        m_ids.clear();
+    }
+
+    void LevelPack::index(Entry entry)
+    {
+        int id = entry.id;
+        m_slotById[id] = m_entries.size();
+        m_entries.push_back(std::move(entry));
+        m_ids.insert(std::upper_bound(m_ids.begin(), m_ids.end(), id), id);
+    }
+
+    const LevelDefinition *LevelPack::find(int id)
+    {
+        auto slot = m_slotById.find(id);
+        if (slot == m_slotById.end())
+            return nullptr;
+
+        Entry &entry = m_entries[slot->second];
+        if (!entry.parsed)
+        {
+            auto level = std::make_unique<LevelDefinition>();
+            if (!level_binary::decode(m_bytes.data() + entry.offset, entry.size, *level))
+                return nullptr;
+            entry.parsed = std::move(level);
+        }
+        return entry.parsed.get();
+    }
+
+    bool LevelPack::readAll(std::vector<LevelDefinition> &levels)
+    {
+        for (int id : m_ids)
+        {
+            const LevelDefinition *level = find(id);
+            if (!level)
+                return false;
+            levels.push_back(*level);
+        }
+        return true;
+    }
+
+    bool LevelPack::load(int id, PhysicsWorld &world, LevelData &data)
+    {
+        const LevelDefinition *level = find(id);
+        if (!level)
+            return false;
+
+        level->build(world);
+        data = level->info;
+        return true;
+    }
+
+    void LevelPack::encode(const std::vector<LevelDefinition> &levels, std::vector<uint8_t> &out)
+    {
+        using namespace byte_io;
+
+        std::vector<const LevelDefinition *> sorted;
+        for (const auto &level : levels)
+            sorted.push_back(&level);
+        std::stable_sort(sorted.begin(), sorted.end(), [](const LevelDefinition *a, const LevelDefinition *b)
+                         { return a->info.id < b->info.id; });
+
+        out.clear();
+        for (char c : MAGIC)
+            out.push_back(static_cast<uint8_t>(c));
+        writeU16(out, VERSION);
+        writeU16(out, 0);
+        writeU32(out, static_cast<uint32_t>(sorted.size()));
+
+        size_t indexAt = out.size();
+        out.resize(indexAt + sorted.size() * INDEX_ENTRY_SIZE);
+
+        std::vector<uint8_t> blob;
+        for (size_t i = 0; i < sorted.size(); i++)
+        {
+            level_binary::encode(*sorted[i], blob);
+
+            size_t entry = indexAt + i * INDEX_ENTRY_SIZE;
+            patchU32(out, entry, static_cast<uint32_t>(sorted[i]->info.id));
+            patchU32(out, entry + 4, static_cast<uint32_t>(out.size()));
+            patchU32(out, entry + 8, static_cast<uint32_t>(blob.size()));
+            out.insert(out.end(), blob.begin(), blob.end());
+        }
+    }
+
+} // namespace slingshot
@@ -0,0 +1,79 @@
+#ifndef SLINGSHOT_GAME_LEVEL_PACK_HPP
+#define SLINGSHOT_GAME_LEVEL_PACK_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "game/level_definition.hpp"
+
+namespace slingshot
+{
+
+    class PhysicsWorld;
+
+    // Every level of the game in one file, read once. Little-endian:
+    //
+    //   Header, 12 bytes
+    //     0  char[4]  magic "SLPK"
+    //     4  u16      format version
+    //     6  u16      reserved, 0
+    //     8  u32      level count
+    //   Index, 12 bytes per level, ascending by id
+    //     0  i32      level id
+    //     4  u32      offset of the level's blob from the start of the file
+    //     8  u32      blob size
+    //   Level blobs in the level_binary format
+    //
+    // Levels are decoded on first use and kept, so reloading one (reset,
+    // retry) only rebuilds the world from the cached definition.
+    class LevelPack
+    {
+    public:
+        static constexpr uint16_t VERSION = 1;
+        static constexpr const char *FILE_NAME = "levels.pack";
+
+        bool open(const std::string &path);
+        bool open(std::vector<uint8_t> bytes);
+
+        // Adds an already parsed level, e.g. one read from JSON during development
+        void add(LevelDefinition level);
+        void clear();
+
+        size_t getLevelCount() const { return m_ids.size(); }
+        const std::vector<int> &getLevelIds() const { return m_ids; } // Ascending
+        bool contains(int id) const { return m_slotById.count(id) != 0; }
+
+        // Parsed level, or nullptr if the pack has no such id
+        const LevelDefinition *find(int id);
+
+        // Appends every level in id order; false if one fails to decode
+        bool readAll(std::vector<LevelDefinition> &levels);
+
+        // Same contract as LevelLoader::load
+        bool load(int id, PhysicsWorld &world, LevelData &data);
+
+        static void encode(const std::vector<LevelDefinition> &levels, std::vector<uint8_t> &out);
+
+    private:
+        struct Entry
+        {
+            int id;
+            uint32_t offset;
+            uint32_t size;
+            std::unique_ptr<LevelDefinition> parsed;
+        };
+
+        void index(Entry entry);
+
+        std::vector<uint8_t> m_bytes;
+        std::vector<Entry> m_entries;
+        std::unordered_map<int, size_t> m_slotById;
+        std::vector<int> m_ids;
+    };
+
+} // namespace slingshot
+
+#endif
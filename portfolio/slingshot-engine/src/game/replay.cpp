@@ -0,0 +1,277 @@
+#include "game/replay.hpp"
+#include "core/byte_io.hpp"
+#include "config/physics.hpp"
+#include "entities/agent.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <memory>
+
+namespace slingshot
+{
+
+    bool ReplayLaunch::operator==(const ReplayLaunch &other) const
+    {
+        return launchTick == other.launchTick &&
+               velocity.x == other.velocity.x && velocity.y == other.velocity.y &&
+               phaseHash == other.phaseHash && flightTicks == other.flightTicks &&
+               outcome == other.outcome;
+    }
+
+    bool Replay::operator==(const Replay &other) const
+    {
+        return levelId == other.levelId && launches == other.launches;
+    }
+
+    namespace replay
+    {
+        using namespace byte_io;
+
+        namespace
+        {
+            constexpr char MAGIC[4] = {'S', 'R', 'P', 'L'};
+
+            // Header field offsets
+            constexpr size_t VERSION_AT = 4;
+            constexpr size_t LEVEL_ID_AT = 8;
+            constexpr size_t LAUNCH_COUNT_AT = 12;
+
+            // Launch record field offsets
+            constexpr size_t LAUNCH_TICK_AT = 0;
+            constexpr size_t VELOCITY_AT = 4;
+            constexpr size_t PHASE_HASH_AT = 12;
+            constexpr size_t FLIGHT_TICKS_AT = 16;
+            constexpr size_t OUTCOME_AT = 20;
+
+            int hexDigit(char c)
+            {
+                if (c >= '0' && c <= '9')
+                    return c - '0';
+                if (c >= 'a' && c <= 'f')
+                    return c - 'a' + 10;
+                if (c >= 'A' && c <= 'F')
+                    return c - 'A' + 10;
+                return -1;
+            }
+        }
+
+        void encode(const Replay &replay, std::vector<uint8_t> &out)
+        {
+            out.clear();
+            out.reserve(HEADER_SIZE + replay.launches.size() * LAUNCH_SIZE);
+            for (char c : MAGIC)
+                out.push_back(static_cast<uint8_t>(c));
+            writeU16(out, VERSION);
+            writeU16(out, 0);
+            writeU32(out, static_cast<uint32_t>(replay.levelId));
+            writeU32(out, static_cast<uint32_t>(replay.launches.size()));
+
+            for (const auto &launch : replay.launches)
+            {
+                writeU32(out, launch.launchTick);
+                writeVec2(out, launch.velocity);
+                writeU32(out, launch.phaseHash);
+                writeU32(out, launch.flightTicks);
+                out.push_back(static_cast<uint8_t>(launch.outcome));
+                out.push_back(0);
+                writeU16(out, 0);
+            }
+        }
+
+        bool decode(const uint8_t *data, size_t size, Replay &replay)
+        {
+            if (size < HEADER_SIZE || std::memcmp(data, MAGIC, sizeof(MAGIC)) != 0 ||
+                readU16(data + VERSION_AT) != VERSION)
+                return false;
+
+            uint32_t count = readU32(data + LAUNCH_COUNT_AT);
+            if (count > MAX_LAUNCHES || size != HEADER_SIZE + count * LAUNCH_SIZE)
+                return false;
+
+            replay = Replay();
+            replay.levelId = static_cast<int32_t>(readU32(data + LEVEL_ID_AT));
+            replay.launches.resize(count);
+            uint64_t totalTicks = 0;
+            for (uint32_t i = 0; i < count; i++)
+            {
+                const uint8_t *record = data + HEADER_SIZE + i * LAUNCH_SIZE;
+                ReplayLaunch &launch = replay.launches[i];
+                launch.launchTick = readU32(record + LAUNCH_TICK_AT);
+                launch.velocity = readVec2(record + VELOCITY_AT);
+                launch.phaseHash = readU32(record + PHASE_HASH_AT);
+                launch.flightTicks = readU32(record + FLIGHT_TICKS_AT);
+
+                uint8_t outcome = record[OUTCOME_AT];
+                if (launch.launchTick > MAX_TICKS || launch.flightTicks > MAX_TICKS ||
+                    outcome > static_cast<uint8_t>(AgentOutcome::OutOfBounds) ||
+                    !std::isfinite(launch.velocity.x) || !std::isfinite(launch.velocity.y))
+                    return false;
+
+                totalTicks += uint64_t(launch.launchTick) + launch.flightTicks;
+                if (totalTicks > MAX_TOTAL_TICKS)
+                    return false;
+                launch.outcome = static_cast<AgentOutcome>(outcome);
+            }
+            return true;
+        }
+
+        std::string toHex(const std::vector<uint8_t> &bytes)
+        {
+            static const char DIGITS[] = "0123456789abcdef";
+            std::string text;
+            text.reserve(bytes.size() * 2);
+            for (uint8_t byte : bytes)
+            {
+                text.push_back(DIGITS[byte >> 4]);
+                text.push_back(DIGITS[byte & 0xF]);
+            }
+            return text;
+        }
+
+        bool fromHex(const std::string &text, std::vector<uint8_t> &out)
+        {
+            out.clear();
+            if (text.size() % 2 != 0)
+                return false;
+
+            out.reserve(text.size() / 2);
+            for (size_t i = 0; i < text.size(); i += 2)
+            {
+                int high = hexDigit(text[i]);
+                int low = hexDigit(text[i + 1]);
+                if (high < 0 || low < 0)
+                    return false;
+                out.push_back(static_cast<uint8_t>(high << 4 | low));
+            }
+            return true;
+        }
+
+        uint32_t hashPositions(const BodyStore &bodies)
+        {
+            uint32_t hash = 2166136261u;
+            auto mix = [&hash](float value)
+            {
+                uint32_t bits;
+                std::memcpy(&bits, &value, sizeof(bits));
+                for (int shift = 0; shift < 32; shift += 8)
+                {
+                    hash ^= (bits >> shift) & 0xFF;
+                    hash *= 16777619u;
+                }
+            };
+
+            for (size_t i = 0; i < bodies.size(); i++)
+            {
+                mix(bodies.posX()[i]);
+                mix(bodies.posY()[i]);
+            }
+            return hash;
+        }
+    }
+
+    void ReplayRecorder::begin(int levelId)
+    {
+        m_replay = Replay();
+        m_replay.levelId = levelId;
+        m_inFlight = false;
+    }
+
+    void ReplayRecorder::recordLaunch(const PhysicsWorld &world, Vec2 velocity)
+    {
+        ReplayLaunch launch;
+        launch.launchTick = static_cast<uint32_t>(std::min<uint64_t>(world.getTick(), UINT32_MAX));
+        launch.velocity = velocity;
+        launch.phaseHash = replay::hashPositions(world.getBodies());
+        m_replay.launches.push_back(launch);
+
+        m_launchTick = world.getTick();
+        m_inFlight = true;
+    }
+
+    void ReplayRecorder::recordEnd(const PhysicsWorld &world, AgentOutcome outcome)
+    {
+        if (!m_inFlight)
+            return;
+
+        ReplayLaunch &launch = m_replay.launches.back();
+        launch.flightTicks = static_cast<uint32_t>(std::min<uint64_t>(world.getTick() - m_launchTick, UINT32_MAX));
+        launch.outcome = outcome;
+        m_inFlight = false;
+    }
+
+    bool ReplayPlayer::play(const LevelDefinition &level, const Replay &replay, ReplayResult &result)
+    {
+        result = ReplayResult();
+        result.attempts = static_cast<int>(replay.launches.size());
+        if (replay.levelId != level.info.id)
+        {
+            result.error = "replay is for another level";
+            return false;
+        }
+
+        m_world.clear();
+        level.build(m_world);
+        m_world.saveState(m_start);
+
+        for (size_t i = 0; i < replay.launches.size(); i++)
+        {
+            if (!playLaunch(level, replay.launches[i], result.error))
+            {
+                result.failedLaunch = i;
+                return false;
+            }
+
+            if (!result.won && replay.launches[i].outcome == AgentOutcome::ReachedGoal)
+            {
+                result.won = true;
+                result.attempts = static_cast<int>(i + 1);
+            }
+        }
+
+        result.valid = true;
+        return true;
+    }
+
+    bool ReplayPlayer::playLaunch(const LevelDefinition &level, const ReplayLaunch &launch, std::string &error)
+    {
+        if (!m_slingshot.canLaunch(launch.velocity))
+        {
+            error = "launch speed out of range";
+            return false;
+        }
+
+        m_world.restoreState(m_start);
+        for (uint32_t tick = 0; tick < launch.launchTick; tick++)
+        {
+            m_world.update(physics::TIME_STEP);
+        }
+
+        if (replay::hashPositions(m_world.getBodies()) != launch.phaseHash)
+        {
+            error = "orbiter phase differs at launch";
+            return false;
+        }
+
+        m_world.addEntity(std::make_unique<Agent>(level.info.spawn));
+        m_world.getAgent()->setVel(launch.velocity);
+
+        // The game stops stepping on the first outcome, so one must land
+        // exactly on the recorded tick (and none at all for a retried flight)
+        AgentOutcome outcome = AgentOutcome::None;
+        uint32_t flown = 0;
+        while (flown < launch.flightTicks && outcome == AgentOutcome::None)
+        {
+            m_world.update(physics::TIME_STEP);
+            outcome = m_world.checkAgent();
+            flown++;
+        }
+
+        if (outcome != launch.outcome || flown != launch.flightTicks)
+        {
+            error = "flight ends differently";
+            return false;
+        }
+        return true;
+    }
+
+} // namespace slingshot
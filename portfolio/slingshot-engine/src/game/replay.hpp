@@ -0,0 +1,127 @@
+#ifndef SLINGSHOT_GAME_REPLAY_HPP
+#define SLINGSHOT_GAME_REPLAY_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "math/vec2.hpp"
+#include "physics/world.hpp"
+#include "game/level_definition.hpp"
+#include "game/slingshot.hpp"
+
+namespace slingshot
+{
+
+    // One launch as the player made it, and how its flight ended
+    struct ReplayLaunch
+    {
+        uint32_t launchTick = 0;  // World ticks from level start to the launch
+        Vec2 velocity;
+        uint32_t phaseHash = 0;   // replay::hashPositions() just before the launch
+        uint32_t flightTicks = 0; // Ticks from the launch to the outcome, or to a retry
+        AgentOutcome outcome = AgentOutcome::None; // None if retried mid-flight
+
+        bool operator==(const ReplayLaunch &other) const;
+    };
+
+    // Input log of a run: every launch on one level since it was loaded. Each
+    // launch starts from the level's start state, as retries restore it.
+    struct Replay
+    {
+        int levelId = 0;
+        std::vector<ReplayLaunch> launches;
+
+        bool operator==(const Replay &other) const;
+        bool operator!=(const Replay &other) const { return !(*this == other); }
+    };
+
+    // Replay format, little-endian:
+    //
+    //   Header, 16 bytes
+    //     0  char[4]  magic "SRPL"
+    //     4  u16      format version
+    //     6  u16      reserved, 0
+    //     8  i32      level id
+    //     12 u32      launch count
+    //   Launch records, 24 bytes each
+    //     0  u32      launch tick
+    //     4  f32 x 2  launch velocity
+    //     12 u32      phase hash
+    //     16 u32      flight ticks
+    //     20 u8       AgentOutcome
+    //     21 u8 x 3   reserved, 0
+    namespace replay
+    {
+        constexpr uint16_t VERSION = 1;
+        constexpr size_t HEADER_SIZE = 16;
+        constexpr size_t LAUNCH_SIZE = 24;
+
+        // Bounds on what decode() accepts, so playback cost stays bounded.
+        // Every launch is re-stepped from the level start, so the whole replay
+        // is capped too: the sum of launchTick + flightTicks over all launches.
+        constexpr uint32_t MAX_LAUNCHES = 1000;
+        constexpr uint32_t MAX_TICKS = 60 * 60 * 10; // Per field: ten minutes of steps
+        constexpr uint64_t MAX_TOTAL_TICKS = MAX_TICKS; // Whole replay: ten minutes of play
+
+        void encode(const Replay &replay, std::vector<uint8_t> &out);
+        bool decode(const uint8_t *data, size_t size, Replay &replay);
+
+        // Lowercase hex of the encoded bytes, for text channels (JS, stdin)
+        std::string toHex(const std::vector<uint8_t> &bytes);
+        bool fromHex(const std::string &text, std::vector<uint8_t> &out);
+
+        // FNV-1a over the bit patterns of every body position
+        uint32_t hashPositions(const BodyStore &bodies);
+    }
+
+    // Builds a Replay from the running game. Ticks are read from the world,
+    // so call each method while it is not being stepped.
+    class ReplayRecorder
+    {
+    public:
+        void begin(int levelId);
+
+        // With the world as it is just before the agent is added
+        void recordLaunch(const PhysicsWorld &world, Vec2 velocity);
+
+        // Closes the launch in flight, if any, at the world's current tick.
+        // Call before restoring the world for a retry.
+        void recordEnd(const PhysicsWorld &world, AgentOutcome outcome);
+
+        const Replay &getReplay() const { return m_replay; }
+
+    private:
+        Replay m_replay;
+        uint64_t m_launchTick = 0;
+        bool m_inFlight = false;
+    };
+
+    struct ReplayResult
+    {
+        bool valid = false;      // Every launch was within the slingshot's range and re-simulated exactly
+        bool won = false;        // Some launch reached the goal
+        int attempts = 0;        // Launches up to and including the first win, else all
+        size_t failedLaunch = 0; // First launch that diverged, when !valid
+        std::string error;
+    };
+
+    // Re-simulates replays headlessly, stepping each launch with the same
+    // fixed time step as the game. The world is kept between calls so a
+    // player can check many replays without reallocating.
+    class ReplayPlayer
+    {
+    public:
+        bool play(const LevelDefinition &level, const Replay &replay, ReplayResult &result);
+
+    private:
+        bool playLaunch(const LevelDefinition &level, const ReplayLaunch &launch, std::string &error);
+
+        PhysicsWorld m_world;
+        WorldState m_start;
+        Slingshot m_slingshot; // As the game configures it, for the launch speeds it allows
+    };
+
+} // namespace slingshot
+
+#endif
@@ -1,5 +1,6 @@
 #include "game/slingshot.hpp"
 #include <algorithm>
+#include <cmath>
 
 namespace slingshot
 {
@@ -15,18 +16,20 @@ namespace slingshot
         if (!m_dragging)
             return;
 
+        m_dragPos = clampDrag(position);
+    }
+
+    Vec2 Slingshot::clampDrag(Vec2 position) const
+    {
         Vec2 diff = position - m_anchor;
         float dist = diff.magnitude();
 
         // Clamp to max radius
         if (dist > m_maxRadius)
         {
-            m_dragPos = m_anchor + diff.normalized() * m_maxRadius;
-        }
-        else
-        {
-            m_dragPos = position;
+            return m_anchor + diff.normalized() * m_maxRadius;
         }
+        return position;
     }
 
     void Slingshot::endDrag()
@@ -56,6 +59,26 @@ namespace slingshot
         return pull * m_launchMultiplier;
     }
 
+    bool Slingshot::canLaunch(Vec2 velocity) const
+    {
+        // A full pull is clamped to the rim, which can land a few ulps outside it
+        constexpr float ROUNDING = 1.0f + 1e-5f;
+        float speed = velocity.magnitude();
+        return speed > MIN_LAUNCH_SPEED && speed <= getMaxLaunchSpeed() * ROUNDING;
+    }
+
+    Vec2 Slingshot::pullVelocity(float angleDegrees, float powerFraction) const
+    {
+        constexpr float PI = 3.14159265358979f;
+        float radians = angleDegrees * PI / 180.0f;
+        Vec2 direction(std::cos(radians), -std::sin(radians)); // Screen y points down
+
+        // Same steps as startDrag/updateDrag/getLaunchVelocity, so the result
+        // matches what the game launches bit for bit
+        Vec2 dragPos = clampDrag(m_anchor - direction * (powerFraction * m_maxRadius));
+        return (m_anchor - dragPos) * m_launchMultiplier;
+    }
+
     float Slingshot::getPower() const
     {
         Vec2 diff = m_dragPos - m_anchor;
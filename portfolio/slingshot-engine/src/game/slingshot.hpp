@@ -20,6 +20,17 @@ namespace slingshot
 
         void setLaunchMultiplier(float mult) { m_launchMultiplier = mult; }
 
+        // Shorter pulls than this are dropped rather than launched
+        static constexpr float MIN_LAUNCH_SPEED = 10.0f;
+        float getMaxLaunchSpeed() const { return m_maxRadius * m_launchMultiplier; }
+
+        // Whether a drag can produce this velocity and the game would launch it
+        bool canLaunch(Vec2 velocity) const;
+
+        // Velocity a drag from the anchor produces when pulled at this angle
+        // (degrees counter-clockwise from +x on screen) and fraction of the radius
+        Vec2 pullVelocity(float angleDegrees, float powerFraction) const;
+
         void onLaunch(LaunchCallback cb) { m_onLaunch = cb; }
 
         // Input handling
@@ -35,6 +46,8 @@ namespace slingshot
         float getPower() const;
 
     private:
+        Vec2 clampDrag(Vec2 position) const;
+
         Vec2 m_anchor{200, 700};
         Vec2 m_dragPos;
         float m_maxRadius = 100.0f;
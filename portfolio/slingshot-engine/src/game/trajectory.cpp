@@ -0,0 +1,146 @@
+#include "game/trajectory.hpp"
+#include "physics/world.hpp"
+#include "entities/goal.hpp"
+#include "core/renderer.hpp"
+#include "physics/collision.hpp"
+#include "config/physics.hpp"
+#include "config/display.hpp"
+#include "config/colors.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+namespace slingshot
+{
+
+    namespace
+    {
+        constexpr size_t NO_GOAL = static_cast<size_t>(-1);
+
+        uint64_t gridKey(Vec2 dragPos)
+        {
+            auto qx = static_cast<int32_t>(std::floor(dragPos.x / physics::PREVIEW_GRID));
+            auto qy = static_cast<int32_t>(std::floor(dragPos.y / physics::PREVIEW_GRID));
+            return (static_cast<uint64_t>(static_cast<uint32_t>(qx)) << 32) | static_cast<uint32_t>(qy);
+        }
+    }
+
+    const std::vector<Vec2> &TrajectoryPreview::update(PhysicsWorld &world, Vec2 spawn, Vec2 dragPos, Vec2 velocity)
+    {
+        // With orbiters in play the path changes every tick, so only reuse within a tick
+        const BodyStore &bodies = world.getBodies();
+        bool dynamic = false;
+        for (size_t i = 0; i < bodies.size() && !dynamic; i++)
+        {
+            dynamic = !bodies.hasFlag(i, body_flags::PINNED);
+        }
+
+        if (dynamic && world.getTick() != m_cacheTick)
+        {
+            invalidate();
+        }
+        m_cacheTick = world.getTick();
+
+        uint64_t key = gridKey(dragPos);
+        auto it = m_cache.find(key);
+        if (it != m_cache.end())
+        {
+            m_points = &it->second;
+            return *m_points;
+        }
+
+        if (m_cache.size() >= static_cast<size_t>(physics::PREVIEW_CACHE_SIZE))
+        {
+            invalidate();
+        }
+
+        std::vector<Vec2> &points = m_cache[key];
+        simulate(world, spawn, velocity, points);
+        m_points = &points;
+        return *m_points;
+    }
+
+    void TrajectoryPreview::invalidate()
+    {
+        m_cache.clear();
+        m_points = &m_empty;
+    }
+
+    void TrajectoryPreview::simulate(PhysicsWorld &world, Vec2 spawn, Vec2 velocity, std::vector<Vec2> &out)
+    {
+        m_bodies = world.getBodies();
+        size_t goal = world.getGoal() ? world.getGoal()->getIndex() : NO_GOAL;
+
+        Body agentBody(EntityType::Agent, spawn, false);
+        agentBody.vel = velocity;
+        size_t agent = m_bodies.add(agentBody);
+        m_grid.rebuild(m_bodies);
+
+        out.clear();
+        out.reserve(physics::PREVIEW_STEPS / physics::PREVIEW_SAMPLE_INTERVAL + 2);
+        out.push_back(spawn);
+
+        for (int step = 1; step <= physics::PREVIEW_STEPS; step++)
+        {
+            m_stepStart.resize(m_bodies.size());
+            for (size_t i = 0; i < m_bodies.size(); i++)
+            {
+                m_stepStart[i] = m_bodies.getPos(i);
+            }
+            world.stepBodies(m_bodies, physics::TIME_STEP);
+            m_grid.update(m_bodies);
+
+            bool ended = flightEnded(agent, goal);
+            if (ended || step % physics::PREVIEW_SAMPLE_INTERVAL == 0)
+            {
+                out.push_back(m_bodies.getPos(agent));
+            }
+            if (ended)
+                break;
+        }
+    }
+
+    bool TrajectoryPreview::flightEnded(size_t agent, size_t goal)
+    {
+        // Same end conditions as the launched game loop: goal, gravity well, bounds,
+        // with contacts swept from the positions at the start of the step
+        Vec2 start = m_stepStart[agent];
+        Vec2 pos = m_bodies.getPos(agent);
+        float agentRadius = m_bodies.radius()[agent];
+
+        float maxTravelSq = 0.0f;
+        for (size_t i = 0; i < m_bodies.size(); i++)
+        {
+            maxTravelSq = std::max(maxTravelSq, m_bodies.getPos(i).distanceSquaredTo(m_stepStart[i]));
+        }
+        float reach = 0.5f * start.distanceTo(pos) + agentRadius + std::sqrt(maxTravelSq);
+
+        m_nearby.clear();
+        m_grid.queryRadius(m_bodies, Vec2::lerp(start, pos, 0.5f), reach, m_nearby);
+        for (size_t i : m_nearby)
+        {
+            if (i == agent)
+                continue;
+
+            float contact = i == goal ? m_bodies.radius()[i] : m_bodies.radius()[i] + agentRadius;
+            if (collision::contactTime(start, pos, m_stepStart[i], m_bodies.getPos(i), contact) != collision::NO_CONTACT)
+                return true;
+        }
+
+        float margin = physics::BOUNDS_MARGIN;
+        return pos.x < -margin ||
+               pos.x > display::WORLD_WIDTH + margin ||
+               pos.y < -margin ||
+               pos.y > display::WORLD_HEIGHT + margin;
+    }
+
+    void TrajectoryPreview::render(Renderer &renderer) const
+    {
+        const std::vector<Vec2> &points = *m_points;
+        for (size_t i = 1; i < points.size(); i++)
+        {
+            renderer.drawDashedLine(points[i - 1], points[i], colors::entity::TRAJECTORY_PREVIEW, 6.0f);
+        }
+    }
+
+} // namespace slingshot
@@ -0,0 +1,47 @@
+#ifndef SLINGSHOT_GAME_TRAJECTORY_HPP
+#define SLINGSHOT_GAME_TRAJECTORY_HPP
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "math/vec2.hpp"
+#include "physics/body_store.hpp"
+#include "physics/spatial_grid.hpp"
+
+namespace slingshot
+{
+
+    class PhysicsWorld;
+    class Renderer;
+
+    // Predicted agent path for the current slingshot drag. The agent is
+    // simulated as a test particle on a copy of the world's bodies, so
+    // orbiters keep moving exactly as they will after launch. Results are
+    // cached per drag-grid cell; levels with moving bodies also key on the
+    // world tick, since the path depends on where the orbiters are.
+    class TrajectoryPreview
+    {
+    public:
+        const std::vector<Vec2> &update(PhysicsWorld &world, Vec2 spawn, Vec2 dragPos, Vec2 velocity);
+        void invalidate();
+
+        const std::vector<Vec2> &getPoints() const { return *m_points; }
+        void render(Renderer &renderer) const;
+
+    private:
+        void simulate(PhysicsWorld &world, Vec2 spawn, Vec2 velocity, std::vector<Vec2> &out);
+        bool flightEnded(size_t agent, size_t goal);
+
+        BodyStore m_bodies;
+        std::vector<Vec2> m_stepStart;
+        SpatialGrid m_grid;
+        std::vector<size_t> m_nearby;
+        std::unordered_map<uint64_t, std::vector<Vec2>> m_cache;
+        uint64_t m_cacheTick = 0;
+        std::vector<Vec2> m_empty;
+        const std::vector<Vec2> *m_points = &m_empty;
+    };
+
+} // namespace slingshot
+
+#endif
@@ -6,16 +6,22 @@
 #include <iostream>
 #include <string>
 #include <memory>
-#include <fstream>
 
 #include "config/colors.hpp"
 #include "config/display.hpp"
 #include "config/physics.hpp"
-#include "core/renderer.hpp"
+#include "core/sdl_renderer.hpp"
 #include "physics/world.hpp"
+#include "physics/physics_thread.hpp"
 #include "game/game.hpp"
 #include "game/slingshot.hpp"
+#include "game/level_pack.hpp"
+#ifndef SLINGSHOT_BINARY_LEVELS
 #include "game/level_loader.hpp"
+#endif
+#include "game/trajectory.hpp"
+#include "game/replay.hpp"
+#include "game/fixed_step.hpp"
 #include "entities/agent.hpp"
 #include "entities/goal.hpp"
 #include "entities/planet.hpp"
@@ -39,33 +45,45 @@ namespace
     bool g_needsLandscape = false;
     int g_totalLevels = 0;
 
-    Renderer g_renderer;
+    SdlRenderer g_renderer;
     PhysicsWorld g_world;
     Game g_game;
     Slingshot g_slingshot;
+    TrajectoryPreview g_preview;
+    LevelPack g_levels;
+
+    // Captured when a level finishes loading; retries and resets restore it
+    WorldState g_levelStart;
+    GameProgress g_levelStartProgress;
+    ReplayRecorder g_replay;
+    FixedStepClock g_clock(physics::TIME_STEP, physics::MAX_STEPS_PER_FRAME);
+    double g_lastFrameMs = 0.0;
+#ifdef SLINGSHOT_THREADS
+    PhysicsThread g_physics(g_world);
+#endif
 
     Vec2 g_spawnPos{200, 700};
 }
 
-int countLevelFiles()
+// Reads every level once at startup: the pack compiled by slingshot_levelc
+// when the build provides it, otherwise the JSON sources. After this, loading
+// a level only rebuilds the world from its cached definition.
+void loadLevels()
 {
-    int count = 0;
-    for (int i = 1; i <= 100; ++i)
+#ifdef SLINGSHOT_BINARY_LEVELS
+    std::string path = std::string("/levels/") + LevelPack::FILE_NAME;
+    if (!g_levels.open(path))
     {
-        std::string path = "/levels/level_" +
-            std::string(i < 10 ? "0" : "") +
-            std::to_string(i) + ".json";
-        std::ifstream file(path);
-        if (file.good())
-        {
-            count++;
-        }
-        else
-        {
-            break;
-        }
+        std::cerr << "Failed to open level pack " << path << std::endl;
     }
-    return count;
+#else
+    std::vector<LevelDefinition> levels;
+    LevelLoader::readAll("/levels", levels);
+    for (LevelDefinition &level : levels)
+    {
+        g_levels.add(std::move(level));
+    }
+#endif
 }
 
 Vec2 screenToWorld(int screenX, int screenY)
@@ -109,6 +127,22 @@ EM_BOOL onCanvasResize(int eventType, const EmscriptenUiEvent *uiEvent, void *us
     return EM_TRUE;
 }
 
+// With physics on a worker, the world may only be touched between batches.
+// Call before mutating it; commitWorld() afterwards republishes the snapshot.
+void syncWorld()
+{
+#ifdef SLINGSHOT_THREADS
+    g_physics.sync();
+#endif
+}
+
+void commitWorld()
+{
+#ifdef SLINGSHOT_THREADS
+    g_physics.publish();
+#endif
+}
+
 void spawnAgent()
 {
     auto agent = std::make_unique<Agent>(g_spawnPos);
@@ -117,49 +151,71 @@ void spawnAgent()
 
 void loadLevel(int levelId)
 {
+    syncWorld();
     g_world.clear();
     g_game.setLevel(levelId);
     g_game.resetAttempts();
-
-    std::string path = "/levels/level_" +
-        std::string(levelId < 10 ? "0" : "") +
-        std::to_string(levelId) + ".json";
+    g_replay.begin(levelId);
 
     LevelData levelData;
-    if (LevelLoader::load(path, g_world, levelData))
+    if (g_levels.load(levelId, g_world, levelData))
     {
         g_spawnPos = levelData.spawn;
         std::cout << "Loaded level: " << levelData.name << std::endl;
     }
     else
     {
-        std::cerr << "Failed to load level from " << path << std::endl;
+        std::cerr << "Failed to load level " << levelId << std::endl;
         g_spawnPos = Vec2(200, 700);
         g_world.addEntity(std::make_unique<Goal>(Vec2(1400, 150)));
         g_world.addEntity(std::make_unique<Planet>(Vec2(800, 450), true, ""));
     }
 
     g_slingshot.setAnchor(g_spawnPos);
+    g_preview.invalidate();
+    g_renderer.invalidateStaticLayer();
     g_game.setState(GameState::Rules);
+
+    g_world.saveState(g_levelStart);
+    g_levelStartProgress = g_game.getProgress();
+    commitWorld();
+}
+
+// Puts the world back to how the level loaded, orbiters included
+void restoreLevelStart()
+{
+    if (!g_world.restoreState(g_levelStart))
+    {
+        // Only if the world changed level without loadLevel
+        loadLevel(g_game.getLevel());
+        return;
+    }
+    g_preview.invalidate();
 }
 
 void launchAgent(Vec2 velocity)
 {
+    syncWorld();
+    g_replay.recordLaunch(g_world, velocity);
     spawnAgent();
 
     if (auto *agent = g_world.getAgent())
     {
-        agent->vel = velocity;
+        agent->setVel(velocity);
     }
 
     g_game.incrementAttempts();
     g_game.setState(GameState::Launched);
+    commitWorld();
 }
 
 void resetForRetry()
 {
-    // Remove current agent
-    g_world.removeAgent();
+    // Remove current agent and rewind orbiters to where the level started
+    syncWorld();
+    g_replay.recordEnd(g_world, AgentOutcome::None);
+    restoreLevelStart();
+    commitWorld();
 
     // Reset slingshot
     g_slingshot.setAnchor(g_spawnPos);
@@ -197,7 +253,7 @@ bool initSDL()
     g_sdlRenderer = SDL_CreateRenderer(
         g_window,
         -1,
-        SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+        SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC | SDL_RENDERER_TARGETTEXTURE);
 
     if (!g_sdlRenderer)
     {
@@ -265,7 +321,7 @@ void handleInput()
                     Vec2 velocity = g_slingshot.getLaunchVelocity();
                     g_slingshot.cancelDrag();
 
-                    if (velocity.magnitude() > 10.0f)
+                    if (g_slingshot.canLaunch(velocity))
                     {
                         launchAgent(velocity);
                     }
@@ -276,24 +332,36 @@ void handleInput()
     }
 }
 
+// Only called while physics is idle
+void applyOutcome(AgentOutcome outcome)
+{
+    if (outcome != AgentOutcome::None)
+    {
+        g_replay.recordEnd(g_world, outcome);
+    }
+
+    switch (outcome)
+    {
+    case AgentOutcome::ReachedGoal:
+        g_game.triggerWin();
+        break;
+    case AgentOutcome::HitGravityWell:
+        g_game.triggerLose(LoseReason::HitGravityWell);
+        break;
+    case AgentOutcome::OutOfBounds:
+        g_game.triggerLose(LoseReason::OutOfBounds);
+        break;
+    case AgentOutcome::None:
+        break;
+    }
+}
+
 void update()
 {
     if (g_game.getState() == GameState::Launched)
     {
         g_world.update(physics::TIME_STEP);
-
-        if (g_world.agentReachedGoal())
-        {
-            g_game.triggerWin();
-        }
-        else if (g_world.agentHitGravityWell())
-        {
-            g_game.triggerLose(LoseReason::HitGravityWell);
-        }
-        else if (g_world.agentOutOfBounds())
-        {
-            g_game.triggerLose(LoseReason::OutOfBounds);
-        }
+        applyOutcome(g_world.checkAgent());
     }
     else if (g_game.getState() == GameState::Aiming)
     {
@@ -302,7 +370,7 @@ void update()
     }
 }
 
-void render()
+void render(float alpha)
 {
     g_renderer.clear(colors::BG_DARK);
 
@@ -317,13 +385,23 @@ void render()
     }
 
     // Render world entities
-    g_world.render(g_renderer);
+#ifdef SLINGSHOT_THREADS
+    g_world.render(g_renderer, g_physics.getSnapshot(), alpha);
+#else
+    g_world.render(g_renderer, alpha);
+#endif
 
     // Render slingshot when aiming
     if (g_game.getState() == GameState::Aiming)
     {
         if (g_slingshot.isDragging())
         {
+            Vec2 velocity = g_slingshot.getLaunchVelocity();
+            if (g_slingshot.canLaunch(velocity))
+            {
+                g_preview.render(g_renderer);
+            }
+
             g_renderer.drawSlingshot(
                 g_slingshot.getAnchor(),
                 g_slingshot.getDragPosition(),
@@ -339,14 +417,72 @@ void render()
     g_renderer.present();
 }
 
+// Reads the world, so it runs while physics is idle
+void updatePreview()
+{
+    if (g_game.getState() != GameState::Aiming || !g_slingshot.isDragging())
+        return;
+
+    Vec2 velocity = g_slingshot.getLaunchVelocity();
+    if (g_slingshot.canLaunch(velocity))
+    {
+        g_preview.update(g_world, g_spawnPos, g_slingshot.getDragPosition(), velocity);
+    }
+}
+
 void mainLoop()
 {
+    // Physics runs at TIME_STEP regardless of the display's refresh rate
+    double now = emscripten_get_now();
+    double frameSeconds = g_lastFrameMs > 0.0 ? (now - g_lastFrameMs) / 1000.0 : physics::TIME_STEP;
+    g_lastFrameMs = now;
+    int steps = g_clock.advance(frameSeconds);
+
+#ifdef SLINGSHOT_THREADS
+    // Collect last frame's batch, then hand the worker this frame's while
+    // the main thread draws the snapshot it published
+    g_physics.sync();
+    g_physics.acquire();
+    if (g_game.getState() == GameState::Launched)
+    {
+        applyOutcome(g_physics.getSnapshot().outcome);
+    }
+
     handleInput();
-    update();
-    render();
+    updatePreview();
+
+    GameState state = g_game.getState();
+    if (state == GameState::Launched || state == GameState::Aiming)
+    {
+        g_physics.requestSteps(steps, state == GameState::Launched);
+    }
+    g_physics.acquire();
+#else
+    handleInput();
+
+    for (int i = 0; i < steps; i++)
+    {
+        update();
+    }
+    updatePreview();
+#endif
+
+    // Physics stops stepping once a run ends, so bodies are drawn at their
+    // last step rather than between it and the one before
+    GameState shown = g_game.getState();
+    bool stepping = shown == GameState::Aiming || shown == GameState::Launched;
+    render(stepping ? g_clock.getAlpha() : 1.0f);
 }
 
 // JS API functions
+// Input log of the current level as hex, for server-side verification
+std::string getReplay()
+{
+    std::vector<uint8_t> bytes;
+    replay::encode(g_replay.getReplay(), bytes);
+    return replay::toHex(bytes);
+}
+
 void startGame()
 {
     if (!g_initialized)
@@ -365,11 +501,12 @@ void startGame()
         g_game.onWin([](int levelId, int attempts)
                      {
             std::cout << "Level " << levelId << " complete in " << attempts << " attempts!" << std::endl;
+            std::string replay = getReplay();
             EM_ASM({
                 if (window.onSlingshotWin) {
-                    window.onSlingshotWin($0, $1);
+                    window.onSlingshotWin($0, $1, UTF8ToString($2));
                 }
-            }, levelId, attempts); });
+            }, levelId, attempts, replay.c_str()); });
 
         g_game.onLose([]()
                       {
@@ -380,7 +517,13 @@ void startGame()
                 }
             }); });
 
-        g_totalLevels = countLevelFiles();
+        loadLevels();
+        g_totalLevels = static_cast<int>(g_levels.getLevelCount());
+#ifdef SLINGSHOT_THREADS
+        // The physics thread plus three force workers fill PTHREAD_POOL_SIZE
+        g_world.setThreadCount(std::min(ThreadPool::hardwareThreads(), 4));
+        g_physics.start();
+#endif
         g_initialized = true;
         loadLevel(1);
         std::cout << "Slingshot game initialized! Found " << g_totalLevels << " levels." << std::endl;
@@ -391,7 +534,13 @@ void startGame()
 
 void resetGame()
 {
-    loadLevel(g_game.getLevel());
+    syncWorld();
+    restoreLevelStart();
+    g_game.restoreProgress(g_levelStartProgress);
+    g_replay.begin(g_game.getLevel());
+    g_slingshot.setAnchor(g_spawnPos);
+    g_slingshot.cancelDrag();
+    commitWorld();
 }
 
 void setLevel(int levelId)
@@ -434,10 +583,7 @@ void dismissRules()
 
 void retryLevel()
 {
-    g_world.removeAgent();
-    g_slingshot.setAnchor(g_spawnPos);
-    g_slingshot.cancelDrag();
-    g_game.setState(GameState::Aiming);
+    resetForRetry();
 }
 
 int getTotalLevels()
@@ -445,6 +591,33 @@ int getTotalLevels()
     return g_totalLevels;
 }
 
+// Frame timing for the last frame
+double getFrameTimeMs()
+{
+    return g_clock.getStats().frameSeconds * 1000.0;
+}
+
+int getStepsLastFrame()
+{
+    return g_clock.getStats().steps;
+}
+
+double getDroppedSteps()
+{
+    return static_cast<double>(g_clock.getStats().droppedSteps);
+}
+
+// Render counters for the last presented frame
+int getDrawCalls()
+{
+    return static_cast<int>(g_renderer.getFrameStats().drawCalls);
+}
+
+int getRenderVertices()
+{
+    return static_cast<int>(g_renderer.getFrameStats().vertices);
+}
+
 EMSCRIPTEN_BINDINGS(slingshot)
 {
     emscripten::function("startGame", &startGame);
@@ -458,4 +631,10 @@ EMSCRIPTEN_BINDINGS(slingshot)
     emscripten::function("needsLandscape", &needsLandscape);
     emscripten::function("dismissRules", &dismissRules);
     emscripten::function("getTotalLevels", &getTotalLevels);
+    emscripten::function("getReplay", &getReplay);
+    emscripten::function("getFrameTimeMs", &getFrameTimeMs);
+    emscripten::function("getStepsLastFrame", &getStepsLastFrame);
+    emscripten::function("getDroppedSteps", &getDroppedSteps);
+    emscripten::function("getDrawCalls", &getDrawCalls);
+    emscripten::function("getRenderVertices", &getRenderVertices);
 }
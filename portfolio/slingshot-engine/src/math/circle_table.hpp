@@ -0,0 +1,60 @@
+#ifndef SLINGSHOT_MATH_CIRCLE_TABLE_HPP
+#define SLINGSHOT_MATH_CIRCLE_TABLE_HPP
+
+namespace slingshot
+{
+
+    // Unit circle sampled at SIZE evenly spaced angles, generated at compile
+    // time. SIZE is divisible by 48 and by every power of two up to 128, so
+    // circles of those segment counts index it with a fixed stride.
+    namespace circle_table
+    {
+        constexpr int SIZE = 384;
+
+        struct Table
+        {
+            float cos[SIZE];
+            float sin[SIZE];
+        };
+
+        namespace detail
+        {
+            constexpr double PI = 3.14159265358979323846;
+
+            // Taylor series about 0; converges to double precision on [-pi, pi]
+            constexpr double series(double x, double term, int firstPower)
+            {
+                double sum = term;
+                for (int n = firstPower; n < firstPower + 48; n += 2)
+                {
+                    term *= -x * x / ((n + 1) * (n + 2));
+                    sum += term;
+                }
+                return sum;
+            }
+
+            constexpr Table makeTable()
+            {
+                Table table{};
+                for (int i = 0; i < SIZE; i++)
+                {
+                    double angle = 2.0 * PI * i / SIZE;
+                    if (angle > PI)
+                        angle -= 2.0 * PI;
+                    table.cos[i] = static_cast<float>(series(angle, 1.0, 0));
+                    table.sin[i] = static_cast<float>(series(angle, angle, 1));
+                }
+                return table;
+            }
+        }
+
+        inline constexpr Table TABLE = detail::makeTable();
+
+        // Point i of a circle with `segments` segments (segments must divide SIZE)
+        constexpr float cosAt(int i, int segments) { return TABLE.cos[(i % segments) * (SIZE / segments)]; }
+        constexpr float sinAt(int i, int segments) { return TABLE.sin[(i % segments) * (SIZE / segments)]; }
+    }
+
+} // namespace slingshot
+
+#endif
@@ -18,6 +18,8 @@ namespace slingshot
         Asteroid
     };
 
+    // Initial description of a body. Entities carry one until they are added
+    // to a PhysicsWorld, which unpacks it into its BodyStore.
     struct Body
     {
         Vec2 pos;
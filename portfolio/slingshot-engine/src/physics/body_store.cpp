@@ -0,0 +1,127 @@
+#include "physics/body_store.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace slingshot
+{
+
+    size_t BodyStore::add(const Body &body)
+    {
+        if (m_size == m_capacity)
+        {
+            grow(m_size + 1);
+        }
+
+        size_t i = m_size++;
+        setPos(i, body.pos);
+        setVel(i, body.vel);
+        mass()[i] = body.mass;
+        radius()[i] = body.radius;
+
+        uint8_t f = 0;
+        if (body.pinned)
+            f |= body_flags::PINNED;
+        if (body.exertsGravity())
+            f |= body_flags::EXERTS_GRAVITY;
+        if (body.isAffectedByGravity())
+            f |= body_flags::AFFECTED_BY_GRAVITY;
+        m_flags[i] = f;
+
+        return i;
+    }
+
+    void BodyStore::remove(size_t index)
+    {
+        if (index >= m_size)
+            return;
+
+        // Preserve order so indices stay in step with the owning entity list
+        size_t tail = m_size - index - 1;
+        for (int f = 0; f < FIELD_COUNT; f++)
+        {
+            float *base = field(static_cast<Field>(f));
+            std::memmove(base + index, base + index + 1, tail * sizeof(float));
+        }
+        std::memmove(m_flags.data() + index, m_flags.data() + index + 1, tail);
+        m_size--;
+    }
+
+    void BodyStore::clear()
+    {
+        m_size = 0;
+    }
+
+    void BodyStore::save(Snapshot &out) const
+    {
+        out.data.assign(m_data.begin(), m_data.end());
+        out.flags.assign(m_flags.begin(), m_flags.end());
+        out.size = m_size;
+    }
+
+    void BodyStore::restore(const Snapshot &snapshot)
+    {
+        if (snapshot.data.size() == m_data.size())
+        {
+            std::memcpy(m_data.data(), snapshot.data.data(), m_data.size() * sizeof(float));
+            std::memcpy(m_flags.data(), snapshot.flags.data(), m_flags.size());
+        }
+        else
+        {
+            // Capacity changed since the save; take the snapshot's layout
+            m_data = snapshot.data;
+            m_flags = snapshot.flags;
+            m_capacity = snapshot.flags.size();
+        }
+        m_size = snapshot.size;
+    }
+
+    uint64_t BodyStore::hashState() const
+    {
+        uint64_t hash = 14695981039346656037ull;
+        auto mix = [&hash](uint32_t value)
+        {
+            for (int shift = 0; shift < 32; shift += 8)
+            {
+                hash ^= (value >> shift) & 0xFF;
+                hash *= 1099511628211ull;
+            }
+        };
+
+        mix(static_cast<uint32_t>(m_size));
+        for (int f = 0; f < FIELD_COUNT; f++)
+        {
+            const float *values = field(static_cast<Field>(f));
+            for (size_t i = 0; i < m_size; i++)
+            {
+                uint32_t bits;
+                std::memcpy(&bits, &values[i], sizeof(bits));
+                mix(bits);
+            }
+        }
+        for (size_t i = 0; i < m_size; i++)
+        {
+            mix(m_flags[i] & static_cast<uint8_t>(~body_flags::SUBSTEPPED));
+        }
+        return hash;
+    }
+
+    void BodyStore::grow(size_t minCapacity)
+    {
+        // Capacity is kept a multiple of 8 so every field starts on a SIMD-width boundary
+        size_t capacity = std::max<size_t>(16, m_capacity * 2);
+        while (capacity < minCapacity)
+            capacity *= 2;
+        capacity = (capacity + 7) & ~static_cast<size_t>(7);
+
+        std::vector<float> data(capacity * FIELD_COUNT, 0.0f);
+        for (int f = 0; f < FIELD_COUNT; f++)
+        {
+            std::copy_n(m_data.data() + f * m_capacity, m_size, data.data() + f * capacity);
+        }
+
+        m_data.swap(data);
+        m_flags.resize(capacity, 0);
+        m_capacity = capacity;
+    }
+
+} // namespace slingshot
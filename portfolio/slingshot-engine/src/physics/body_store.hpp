@@ -0,0 +1,112 @@
+#ifndef SLINGSHOT_PHYSICS_BODY_STORE_HPP
+#define SLINGSHOT_PHYSICS_BODY_STORE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "math/vec2.hpp"
+#include "physics/body.hpp"
+
+namespace slingshot
+{
+
+    namespace body_flags
+    {
+        constexpr uint8_t PINNED = 1 << 0;
+        constexpr uint8_t EXERTS_GRAVITY = 1 << 1;
+        constexpr uint8_t AFFECTED_BY_GRAVITY = 1 << 2;
+        constexpr uint8_t SUBSTEPPED = 1 << 3; // Transient: integrated separately this step
+    }
+
+    // Structure-of-arrays storage for simulated bodies.
+    // All float fields live in one contiguous block, laid out field by field
+    // (pos.x[capacity], pos.y[capacity], vel.x[capacity], ...), so the gravity
+    // loops stream through packed arrays and the whole state copies in one go.
+    class BodyStore
+    {
+    public:
+        // Verbatim copy of the float block and flags. Restoring into a store of
+        // the same capacity is one memcpy per array.
+        struct Snapshot
+        {
+            std::vector<float> data;
+            std::vector<uint8_t> flags;
+            size_t size = 0;
+        };
+
+        size_t size() const { return m_size; }
+        bool empty() const { return m_size == 0; }
+
+        size_t add(const Body &body);
+        void remove(size_t index);
+        void clear();
+
+        // Reuses the snapshot's buffers, so repeated saves do not allocate
+        void save(Snapshot &out) const;
+        void restore(const Snapshot &snapshot);
+
+        // FNV-1a over the bit patterns of every field of every body, plus the
+        // persistent flags. Equal hashes mean bit-identical bodies.
+        uint64_t hashState() const;
+
+        float *posX() { return field(POS_X); }
+        float *posY() { return field(POS_Y); }
+        float *velX() { return field(VEL_X); }
+        float *velY() { return field(VEL_Y); }
+        float *mass() { return field(MASS); }
+        float *radius() { return field(RADIUS); }
+        uint8_t *flags() { return m_flags.data(); }
+
+        const float *posX() const { return field(POS_X); }
+        const float *posY() const { return field(POS_Y); }
+        const float *velX() const { return field(VEL_X); }
+        const float *velY() const { return field(VEL_Y); }
+        const float *mass() const { return field(MASS); }
+        const float *radius() const { return field(RADIUS); }
+        const uint8_t *flags() const { return m_flags.data(); }
+
+        Vec2 getPos(size_t i) const { return Vec2(posX()[i], posY()[i]); }
+        Vec2 getVel(size_t i) const { return Vec2(velX()[i], velY()[i]); }
+
+        void setPos(size_t i, Vec2 p)
+        {
+            posX()[i] = p.x;
+            posY()[i] = p.y;
+        }
+
+        void setVel(size_t i, Vec2 v)
+        {
+            velX()[i] = v.x;
+            velY()[i] = v.y;
+        }
+
+        bool hasFlag(size_t i, uint8_t flag) const { return (m_flags[i] & flag) != 0; }
+        void setFlag(size_t i, uint8_t flag) { m_flags[i] |= flag; }
+        void clearFlag(size_t i, uint8_t flag) { m_flags[i] &= static_cast<uint8_t>(~flag); }
+
+    private:
+        enum Field
+        {
+            POS_X,
+            POS_Y,
+            VEL_X,
+            VEL_Y,
+            MASS,
+            RADIUS,
+            FIELD_COUNT
+        };
+
+        float *field(Field f) { return m_data.data() + f * m_capacity; }
+        const float *field(Field f) const { return m_data.data() + f * m_capacity; }
+
+        void grow(size_t minCapacity);
+
+        std::vector<float> m_data;
+        std::vector<uint8_t> m_flags;
+        size_t m_size = 0;
+        size_t m_capacity = 0;
+    };
+
+} // namespace slingshot
+
+#endif
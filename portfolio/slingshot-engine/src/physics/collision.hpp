@@ -0,0 +1,52 @@
+#ifndef SLINGSHOT_PHYSICS_COLLISION_HPP
+#define SLINGSHOT_PHYSICS_COLLISION_HPP
+
+#include <cmath>
+#include "math/vec2.hpp"
+
+namespace slingshot
+{
+
+    namespace collision
+    {
+        constexpr float NO_CONTACT = -1.0f;
+
+        // Earliest fraction t in [0, 1] of the step at which a point moving from
+        // `start` by `delta` comes within `reach` of the origin, or NO_CONTACT.
+        // A point that starts inside reports 0.
+        inline float sweptContactTime(Vec2 start, Vec2 delta, float reach)
+        {
+            float c = start.magnitudeSquared() - reach * reach;
+            if (c < 0.0f)
+                return 0.0f;
+
+            float a = delta.magnitudeSquared();
+            float b = start.dot(delta);
+            if (a <= 0.0f || b >= 0.0f)
+                return NO_CONTACT; // Not moving, or moving away
+
+            float disc = b * b - a * c;
+            if (disc < 0.0f)
+                return NO_CONTACT;
+
+            float t = (-b - std::sqrt(disc)) / a;
+            return t <= 1.0f ? t : NO_CONTACT;
+        }
+
+        // Swept test between two circles that both moved during the step,
+        // done in the frame of the second one
+        inline float contactTime(Vec2 aStart, Vec2 aEnd, Vec2 bStart, Vec2 bEnd, float reach)
+        {
+            return sweptContactTime(aStart - bStart, (aEnd - aStart) - (bEnd - bStart), reach);
+        }
+
+        // True if contact `t` happens, and no later than `other`
+        inline bool isFirstContact(float t, float other)
+        {
+            return t != NO_CONTACT && (other == NO_CONTACT || t <= other);
+        }
+    }
+
+} // namespace slingshot
+
+#endif
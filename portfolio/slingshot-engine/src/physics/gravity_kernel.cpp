@@ -0,0 +1,265 @@
+#include "physics/gravity_kernel.hpp"
+#include "config/physics.hpp"
+#include <cmath>
+
+// Deterministic builds fix the kernel at four lanes, so every target sums in
+// the same order: SSE2 even where AVX2 is available, and without SIMD a
+// portable four-lane loop in place of the scalar one
+#if !defined(SLINGSHOT_DISABLE_SIMD)
+#if defined(__AVX2__) && !defined(SLINGSHOT_DETERMINISTIC)
+#include <immintrin.h>
+#define SLINGSHOT_GRAVITY_AVX2
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define SLINGSHOT_GRAVITY_SSE2
+#elif defined(__wasm_simd128__)
+#include <wasm_simd128.h>
+#define SLINGSHOT_GRAVITY_WASM
+#endif
+#endif
+
+#if defined(SLINGSHOT_DETERMINISTIC) && !defined(SLINGSHOT_GRAVITY_SSE2) && !defined(SLINGSHOT_GRAVITY_WASM)
+#define SLINGSHOT_GRAVITY_PORTABLE
+#endif
+
+namespace slingshot
+{
+
+    void GravitySources::gather(const BodyStore &bodies)
+    {
+        x.clear();
+        y.clear();
+        mass.clear();
+        radius.clear();
+        index.clear();
+
+        const uint8_t *flags = bodies.flags();
+        for (size_t i = 0; i < bodies.size(); i++)
+        {
+            if (!(flags[i] & body_flags::EXERTS_GRAVITY))
+                continue;
+            x.push_back(bodies.posX()[i]);
+            y.push_back(bodies.posY()[i]);
+            mass.push_back(bodies.mass()[i]);
+            radius.push_back(bodies.radius()[i]);
+            index.push_back(static_cast<int>(i));
+        }
+    }
+
+    namespace
+    {
+        // Per-lane operations for each instruction set. The kernel below is
+        // written once against this interface and mirrors the scalar loop
+        // operation for operation, so each source's term is bit-identical;
+        // only the order of the final summation differs.
+#if defined(SLINGSHOT_GRAVITY_AVX2)
+        struct Lanes
+        {
+            using V = __m256;
+            static constexpr size_t WIDTH = 8;
+            static V load(const float *p) { return _mm256_loadu_ps(p); }
+            static V set(float v) { return _mm256_set1_ps(v); }
+            static V add(V a, V b) { return _mm256_add_ps(a, b); }
+            static V sub(V a, V b) { return _mm256_sub_ps(a, b); }
+            static V mul(V a, V b) { return _mm256_mul_ps(a, b); }
+            static V div(V a, V b) { return _mm256_div_ps(a, b); }
+            static V sqrt(V a) { return _mm256_sqrt_ps(a); }
+            static V max(V a, V b) { return _mm256_max_ps(a, b); }
+            static V keepIfGreaterEqual(V v, V a, V b) { return _mm256_and_ps(v, _mm256_cmp_ps(a, b, _CMP_GE_OQ)); }
+            static float sum(V v)
+            {
+                alignas(32) float t[8];
+                _mm256_store_ps(t, v);
+                return ((t[0] + t[1]) + (t[2] + t[3])) + ((t[4] + t[5]) + (t[6] + t[7]));
+            }
+        };
+#elif defined(SLINGSHOT_GRAVITY_SSE2)
+        struct Lanes
+        {
+            using V = __m128;
+            static constexpr size_t WIDTH = 4;
+            static V load(const float *p) { return _mm_loadu_ps(p); }
+            static V set(float v) { return _mm_set1_ps(v); }
+            static V add(V a, V b) { return _mm_add_ps(a, b); }
+            static V sub(V a, V b) { return _mm_sub_ps(a, b); }
+            static V mul(V a, V b) { return _mm_mul_ps(a, b); }
+            static V div(V a, V b) { return _mm_div_ps(a, b); }
+            static V sqrt(V a) { return _mm_sqrt_ps(a); }
+            static V max(V a, V b) { return _mm_max_ps(a, b); }
+            static V keepIfGreaterEqual(V v, V a, V b) { return _mm_and_ps(v, _mm_cmpge_ps(a, b)); }
+            static float sum(V v)
+            {
+                alignas(16) float t[4];
+                _mm_store_ps(t, v);
+                return (t[0] + t[1]) + (t[2] + t[3]);
+            }
+        };
+#elif defined(SLINGSHOT_GRAVITY_WASM)
+        struct Lanes
+        {
+            using V = v128_t;
+            static constexpr size_t WIDTH = 4;
+            static V load(const float *p) { return wasm_v128_load(p); }
+            static V set(float v) { return wasm_f32x4_splat(v); }
+            static V add(V a, V b) { return wasm_f32x4_add(a, b); }
+            static V sub(V a, V b) { return wasm_f32x4_sub(a, b); }
+            static V mul(V a, V b) { return wasm_f32x4_mul(a, b); }
+            static V div(V a, V b) { return wasm_f32x4_div(a, b); }
+            static V sqrt(V a) { return wasm_f32x4_sqrt(a); }
+            static V max(V a, V b) { return wasm_f32x4_pmax(a, b); }
+            static V keepIfGreaterEqual(V v, V a, V b) { return wasm_v128_and(v, wasm_f32x4_ge(a, b)); }
+            static float sum(V v)
+            {
+                return (wasm_f32x4_extract_lane(v, 0) + wasm_f32x4_extract_lane(v, 1)) +
+                       (wasm_f32x4_extract_lane(v, 2) + wasm_f32x4_extract_lane(v, 3));
+            }
+        };
+#elif defined(SLINGSHOT_GRAVITY_PORTABLE)
+        // Plain floats laid out as four lanes, with the SSE2 semantics of max
+        // and the compare mask, for deterministic builds without SIMD
+        struct Lanes
+        {
+            struct V
+            {
+                float lane[4];
+            };
+            static constexpr size_t WIDTH = 4;
+
+            template <typename Op>
+            static V map(V a, V b, Op op)
+            {
+                return {{op(a.lane[0], b.lane[0]), op(a.lane[1], b.lane[1]), op(a.lane[2], b.lane[2]), op(a.lane[3], b.lane[3])}};
+            }
+
+            static V load(const float *p) { return {{p[0], p[1], p[2], p[3]}}; }
+            static V set(float v) { return {{v, v, v, v}}; }
+            static V add(V a, V b) { return map(a, b, [](float x, float y) { return x + y; }); }
+            static V sub(V a, V b) { return map(a, b, [](float x, float y) { return x - y; }); }
+            static V mul(V a, V b) { return map(a, b, [](float x, float y) { return x * y; }); }
+            static V div(V a, V b) { return map(a, b, [](float x, float y) { return x / y; }); }
+            static V sqrt(V a) { return map(a, a, [](float x, float) { return std::sqrt(x); }); }
+            static V max(V a, V b) { return map(a, b, [](float x, float y) { return x > y ? x : y; }); }
+            static V keepIfGreaterEqual(V v, V a, V b)
+            {
+                V kept;
+                for (size_t i = 0; i < WIDTH; i++)
+                    kept.lane[i] = a.lane[i] >= b.lane[i] ? v.lane[i] : 0.0f;
+                return kept;
+            }
+            static float sum(V v) { return (v.lane[0] + v.lane[1]) + (v.lane[2] + v.lane[3]); }
+        };
+#endif
+
+        // Matches Vec2::normalized(): directions shorter than this are treated as zero
+        constexpr float MIN_DIRECTION = 1e-8f;
+
+        constexpr int NO_EXCLUDE = -1;
+
+        Vec2 accumulateScalar(const GravitySources &sources, size_t begin, Vec2 pos, float radius, int exclude = NO_EXCLUDE)
+        {
+            Vec2 total(0, 0);
+            for (size_t i = begin; i < sources.size(); i++)
+            {
+                if (sources.index[i] == exclude)
+                    continue;
+
+                Vec2 direction(sources.x[i] - pos.x, sources.y[i] - pos.y);
+                float distSq = direction.magnitudeSquared();
+
+                float minDist = sources.radius[i] + radius;
+                if (distSq < minDist * minDist)
+                {
+                    distSq = minDist * minDist;
+                }
+
+                float accelMag = physics::G * sources.mass[i] / distSq;
+                total += direction.normalized() * accelMag;
+            }
+            return total;
+        }
+    }
+
+    namespace gravity
+    {
+
+        Vec2 accelerationAtScalar(const GravitySources &sources, Vec2 pos, float radius)
+        {
+            return accumulateScalar(sources, 0, pos, radius);
+        }
+
+        Vec2 accelerationExcluding(const GravitySources &sources, Vec2 pos, float radius, int exclude)
+        {
+            return accumulateScalar(sources, 0, pos, radius, exclude);
+        }
+
+#if defined(SLINGSHOT_GRAVITY_AVX2) || defined(SLINGSHOT_GRAVITY_SSE2) || defined(SLINGSHOT_GRAVITY_WASM) || \
+    defined(SLINGSHOT_GRAVITY_PORTABLE)
+
+        Vec2 accelerationAt(const GravitySources &sources, Vec2 pos, float radius)
+        {
+            using V = Lanes::V;
+
+            const V px = Lanes::set(pos.x);
+            const V py = Lanes::set(pos.y);
+            const V r = Lanes::set(radius);
+            const V g = Lanes::set(physics::G);
+            const V minDirection = Lanes::set(MIN_DIRECTION);
+
+            V ax = Lanes::set(0.0f);
+            V ay = Lanes::set(0.0f);
+
+            size_t count = sources.size();
+            size_t vectorEnd = count - count % Lanes::WIDTH;
+
+            for (size_t i = 0; i < vectorEnd; i += Lanes::WIDTH)
+            {
+                V dx = Lanes::sub(Lanes::load(&sources.x[i]), px);
+                V dy = Lanes::sub(Lanes::load(&sources.y[i]), py);
+                V distSq = Lanes::add(Lanes::mul(dx, dx), Lanes::mul(dy, dy));
+                V mag = Lanes::sqrt(distSq);
+
+                V minDist = Lanes::add(Lanes::load(&sources.radius[i]), r);
+                distSq = Lanes::max(distSq, Lanes::mul(minDist, minDist));
+
+                V accelMag = Lanes::div(Lanes::mul(g, Lanes::load(&sources.mass[i])), distSq);
+                V termX = Lanes::mul(Lanes::div(dx, mag), accelMag);
+                V termY = Lanes::mul(Lanes::div(dy, mag), accelMag);
+
+                ax = Lanes::add(ax, Lanes::keepIfGreaterEqual(termX, mag, minDirection));
+                ay = Lanes::add(ay, Lanes::keepIfGreaterEqual(termY, mag, minDirection));
+            }
+
+            Vec2 total(Lanes::sum(ax), Lanes::sum(ay));
+            return total + accumulateScalar(sources, vectorEnd, pos, radius);
+        }
+
+        const char *kernelName()
+        {
+#if defined(SLINGSHOT_GRAVITY_AVX2)
+            return "avx2";
+#elif defined(SLINGSHOT_GRAVITY_SSE2)
+            return "sse2";
+#elif defined(SLINGSHOT_GRAVITY_WASM)
+            return "wasm-simd128";
+#else
+            return "portable-x4";
+#endif
+        }
+
+#else
+
+        Vec2 accelerationAt(const GravitySources &sources, Vec2 pos, float radius)
+        {
+            return accumulateScalar(sources, 0, pos, radius);
+        }
+
+        const char *kernelName()
+        {
+            return "scalar";
+        }
+
+#endif
+
+    } // namespace gravity
+
+} // namespace slingshot
@@ -0,0 +1,47 @@
+#ifndef SLINGSHOT_PHYSICS_GRAVITY_KERNEL_HPP
+#define SLINGSHOT_PHYSICS_GRAVITY_KERNEL_HPP
+
+#include <cstddef>
+#include <vector>
+#include "math/vec2.hpp"
+#include "physics/body_store.hpp"
+
+namespace slingshot
+{
+
+    // Packed copy of the gravity-exerting bodies for one step, so the
+    // pairwise kernel runs over dense arrays with no per-body flag checks.
+    struct GravitySources
+    {
+        std::vector<float> x;
+        std::vector<float> y;
+        std::vector<float> mass;
+        std::vector<float> radius;
+        std::vector<int> index; // BodyStore index of each source
+
+        size_t size() const { return x.size(); }
+        void gather(const BodyStore &bodies);
+    };
+
+    namespace gravity
+    {
+        // Acceleration at `pos` for a body of `radius`, summed over all sources.
+        // A source at the exact same position contributes nothing, which is how
+        // a body's own entry drops out of the sum.
+        Vec2 accelerationAt(const GravitySources &sources, Vec2 pos, float radius);
+
+        // Plain loop kept as the reference the vector kernels are checked against
+        Vec2 accelerationAtScalar(const GravitySources &sources, Vec2 pos, float radius);
+
+        // Scalar sum that skips the source with BodyStore index `exclude`, for
+        // bodies integrated against sources that no longer share their position
+        Vec2 accelerationExcluding(const GravitySources &sources, Vec2 pos, float radius, int exclude);
+
+        // Name of the kernel selected at build time ("avx2", "sse2", "wasm-simd128",
+        // "portable-x4" or "scalar")
+        const char *kernelName();
+    }
+
+} // namespace slingshot
+
+#endif
@@ -0,0 +1,109 @@
+#include "physics/physics_thread.hpp"
+#include "physics/world.hpp"
+#include "config/physics.hpp"
+
+namespace slingshot
+{
+
+    PhysicsThread::PhysicsThread(PhysicsWorld &world)
+        : m_world(world)
+    {
+    }
+
+    PhysicsThread::~PhysicsThread()
+    {
+        stop();
+    }
+
+    void PhysicsThread::start()
+    {
+        if (m_thread.joinable())
+            return;
+
+        m_quit = false;
+        m_thread = std::thread(&PhysicsThread::run, this);
+    }
+
+    void PhysicsThread::stop()
+    {
+        if (!m_thread.joinable())
+            return;
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_quit = true;
+        }
+        m_wake.notify_one();
+        m_thread.join();
+    }
+
+    void PhysicsThread::requestSteps(int steps, bool watchAgent)
+    {
+        if (steps <= 0)
+            return;
+
+        if (!m_thread.joinable())
+        {
+            // Not started: step inline so callers behave the same either way
+            stepBatch(steps, watchAgent);
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_pendingSteps = steps;
+            m_watchAgent = watchAgent;
+            m_busy = true;
+        }
+        m_wake.notify_one();
+    }
+
+    void PhysicsThread::sync()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_idle.wait(lock, [this]
+                    { return !m_busy; });
+    }
+
+    void PhysicsThread::publish()
+    {
+        m_world.captureSnapshot(m_snapshots.back());
+        m_snapshots.publish();
+    }
+
+    void PhysicsThread::run()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (true)
+        {
+            m_wake.wait(lock, [this]
+                        { return m_quit || m_busy; });
+            if (m_quit)
+                break;
+
+            int steps = m_pendingSteps;
+            bool watchAgent = m_watchAgent;
+            lock.unlock();
+
+            stepBatch(steps, watchAgent);
+
+            lock.lock();
+            m_busy = false;
+            m_idle.notify_all();
+        }
+    }
+
+    void PhysicsThread::stepBatch(int steps, bool watchAgent)
+    {
+        for (int i = 0; i < steps; i++)
+        {
+            m_world.update(physics::TIME_STEP);
+
+            // Once the flight is over the world should stay where it ended
+            if (watchAgent && m_world.checkAgent() != AgentOutcome::None)
+                break;
+        }
+        publish();
+    }
+
+} // namespace slingshot
@@ -0,0 +1,68 @@
+#ifndef SLINGSHOT_PHYSICS_PHYSICS_THREAD_HPP
+#define SLINGSHOT_PHYSICS_PHYSICS_THREAD_HPP
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include "core/triple_buffer.hpp"
+#include "physics/world_snapshot.hpp"
+
+namespace slingshot
+{
+
+    class PhysicsWorld;
+
+    // Steps a PhysicsWorld on a worker thread and hands the results to the
+    // render thread as WorldSnapshots through a lock-free triple buffer.
+    //
+    // The world belongs to the worker between requestSteps() and the next
+    // sync(); outside that window the caller may read and mutate it freely
+    // (launching, loading levels, previews) and publish() the result.
+    class PhysicsThread
+    {
+    public:
+        explicit PhysicsThread(PhysicsWorld &world);
+        ~PhysicsThread();
+
+        PhysicsThread(const PhysicsThread &) = delete;
+        PhysicsThread &operator=(const PhysicsThread &) = delete;
+
+        void start();
+        void stop();
+        bool isRunning() const { return m_thread.joinable(); }
+
+        // Runs `steps` fixed steps in the background. With watchAgent set the
+        // batch stops early on the first step that ends the agent's flight.
+        // Call sync() before requesting the next batch.
+        void requestSteps(int steps, bool watchAgent);
+
+        // Waits for the requested batch to finish
+        void sync();
+
+        // Snapshots the world from the calling thread (only while synced)
+        void publish();
+
+        // Render side: picks up the newest snapshot, true if it changed
+        bool acquire() { return m_snapshots.acquire(); }
+        const WorldSnapshot &getSnapshot() const { return m_snapshots.front(); }
+
+    private:
+        void run();
+        void stepBatch(int steps, bool watchAgent);
+
+        PhysicsWorld &m_world;
+        TripleBuffer<WorldSnapshot> m_snapshots;
+
+        std::thread m_thread;
+        std::mutex m_mutex;
+        std::condition_variable m_wake;
+        std::condition_variable m_idle;
+        int m_pendingSteps = 0;
+        bool m_watchAgent = false;
+        bool m_busy = false;
+        bool m_quit = false;
+    };
+
+} // namespace slingshot
+
+#endif
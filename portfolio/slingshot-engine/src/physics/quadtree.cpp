@@ -0,0 +1,194 @@
+#include "physics/quadtree.hpp"
+#include "config/physics.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace slingshot
+{
+
+    namespace
+    {
+        Vec2 pairAcceleration(Vec2 targetPos, float targetRadius, Vec2 sourcePos, float sourceMass, float sourceRadius)
+        {
+            Vec2 direction = sourcePos - targetPos;
+            float distSq = direction.magnitudeSquared();
+
+            float minDist = sourceRadius + targetRadius;
+            if (distSq < minDist * minDist)
+            {
+                distSq = minDist * minDist;
+            }
+
+            float accelMag = physics::G * sourceMass / distSq;
+            return direction.normalized() * accelMag;
+        }
+    }
+
+    void QuadTree::clear()
+    {
+        m_nodes.clear();
+        m_sources.clear();
+    }
+
+    void QuadTree::build(const std::vector<Source> &sources)
+    {
+        clear();
+        if (sources.empty())
+            return;
+
+        m_sources = sources;
+
+        Vec2 minPos = m_sources[0].pos;
+        Vec2 maxPos = m_sources[0].pos;
+        for (const auto &s : m_sources)
+        {
+            minPos.x = std::min(minPos.x, s.pos.x);
+            minPos.y = std::min(minPos.y, s.pos.y);
+            maxPos.x = std::max(maxPos.x, s.pos.x);
+            maxPos.y = std::max(maxPos.y, s.pos.y);
+        }
+
+        // Square root cell, slightly padded so boundary sources fall strictly inside
+        float halfSize = std::max(maxPos.x - minPos.x, maxPos.y - minPos.y) * 0.5f + 1.0f;
+
+        Node root{};
+        root.center = (minPos + maxPos) * 0.5f;
+        root.halfSize = halfSize;
+        root.begin = 0;
+        root.end = static_cast<int>(m_sources.size());
+
+        m_nodes.reserve(m_sources.size() * 2);
+        m_nodes.push_back(root);
+        buildNode(0, 0);
+    }
+
+    void QuadTree::buildNode(int nodeIndex, int depth)
+    {
+        Node node = m_nodes[nodeIndex];
+
+        Vec2 weighted(0, 0);
+        float mass = 0.0f;
+        float maxRadius = 0.0f;
+        for (int i = node.begin; i < node.end; i++)
+        {
+            const Source &s = m_sources[i];
+            weighted += s.pos * s.mass;
+            mass += s.mass;
+            maxRadius = std::max(maxRadius, s.radius);
+        }
+
+        node.mass = mass;
+        node.maxRadius = maxRadius;
+        node.centerOfMass = mass > 0.0f ? weighted / mass : node.center;
+        node.firstChild = -1;
+
+        if (node.end - node.begin <= LEAF_CAPACITY || depth >= MAX_DEPTH)
+        {
+            m_nodes[nodeIndex] = node;
+            return;
+        }
+
+        // Partition sources into quadrants: [top-left, top-right, bottom-left, bottom-right]
+        auto first = m_sources.begin() + node.begin;
+        auto last = m_sources.begin() + node.end;
+        Vec2 c = node.center;
+        auto splitY = std::partition(first, last, [c](const Source &s)
+                                     { return s.pos.y < c.y; });
+        auto splitTop = std::partition(first, splitY, [c](const Source &s)
+                                       { return s.pos.x < c.x; });
+        auto splitBottom = std::partition(splitY, last, [c](const Source &s)
+                                          { return s.pos.x < c.x; });
+
+        int bounds[5] = {
+            node.begin,
+            static_cast<int>(splitTop - m_sources.begin()),
+            static_cast<int>(splitY - m_sources.begin()),
+            static_cast<int>(splitBottom - m_sources.begin()),
+            node.end};
+
+        float childHalf = node.halfSize * 0.5f;
+        const Vec2 offsets[4] = {
+            Vec2(-childHalf, -childHalf),
+            Vec2(childHalf, -childHalf),
+            Vec2(-childHalf, childHalf),
+            Vec2(childHalf, childHalf)};
+
+        node.firstChild = static_cast<int>(m_nodes.size());
+        m_nodes[nodeIndex] = node;
+
+        for (int q = 0; q < 4; q++)
+        {
+            Node child{};
+            child.center = c + offsets[q];
+            child.halfSize = childHalf;
+            child.begin = bounds[q];
+            child.end = bounds[q + 1];
+            m_nodes.push_back(child);
+        }
+
+        for (int q = 0; q < 4; q++)
+        {
+            int childIndex = node.firstChild + q;
+            if (m_nodes[childIndex].end > m_nodes[childIndex].begin)
+            {
+                buildNode(childIndex, depth + 1);
+            }
+            else
+            {
+                m_nodes[childIndex].firstChild = -1;
+            }
+        }
+    }
+
+    Vec2 QuadTree::accelerationAt(Vec2 pos, float radius, int selfIndex, float theta) const
+    {
+        Vec2 total(0, 0);
+        if (m_nodes.empty())
+            return total;
+
+        // Each visit pushes at most four children, so this bounds the traversal stack
+        int stack[3 * MAX_DEPTH + 8];
+        int top = 0;
+        stack[top++] = 0;
+
+        float thetaSq = theta * theta;
+
+        while (top > 0)
+        {
+            const Node &node = m_nodes[stack[--top]];
+            if (node.mass <= 0.0f)
+                continue;
+
+            if (node.firstChild < 0)
+            {
+                for (int i = node.begin; i < node.end; i++)
+                {
+                    const Source &s = m_sources[i];
+                    if (s.index == selfIndex)
+                        continue;
+                    total += pairAcceleration(pos, radius, s.pos, s.mass, s.radius);
+                }
+                continue;
+            }
+
+            bool inside = std::abs(pos.x - node.center.x) <= node.halfSize &&
+                          std::abs(pos.y - node.center.y) <= node.halfSize;
+            float size = node.halfSize * 2.0f;
+            float distSq = pos.distanceSquaredTo(node.centerOfMass);
+
+            if (!inside && size * size < thetaSq * distSq)
+            {
+                total += pairAcceleration(pos, radius, node.centerOfMass, node.mass, node.maxRadius);
+                continue;
+            }
+
+            for (int q = 0; q < 4; q++)
+            {
+                stack[top++] = node.firstChild + q;
+            }
+        }
+
+        return total;
+    }
+
+} // namespace slingshot
@@ -0,0 +1,57 @@
+#ifndef SLINGSHOT_PHYSICS_QUADTREE_HPP
+#define SLINGSHOT_PHYSICS_QUADTREE_HPP
+
+#include <cstddef>
+#include <vector>
+#include "math/vec2.hpp"
+
+namespace slingshot
+{
+
+    // Barnes-Hut quadtree over the gravity sources of a single step.
+    // Distant groups of sources are approximated by their centre of mass
+    // once a node's size / distance ratio drops below the opening angle theta.
+    class QuadTree
+    {
+    public:
+        struct Source
+        {
+            Vec2 pos;
+            float mass;
+            float radius;
+            int index; // Caller's body index, used to skip self-interaction
+        };
+
+        void build(const std::vector<Source> &sources);
+        void clear();
+
+        // Gravitational acceleration at `pos` (excluding the source with `selfIndex`)
+        Vec2 accelerationAt(Vec2 pos, float radius, int selfIndex, float theta) const;
+
+        size_t getNodeCount() const { return m_nodes.size(); }
+
+    private:
+        static constexpr int LEAF_CAPACITY = 4;
+        static constexpr int MAX_DEPTH = 24;
+
+        struct Node
+        {
+            Vec2 center;       // Geometric centre of the cell
+            float halfSize;    // Half of the cell's side length
+            Vec2 centerOfMass;
+            float mass;
+            float maxRadius;   // Largest source radius in the subtree (for softening)
+            int firstChild;    // Index of the first of four children, -1 for leaves
+            int begin;         // Source range [begin, end) covered by this node
+            int end;
+        };
+
+        void buildNode(int nodeIndex, int depth);
+
+        std::vector<Node> m_nodes;
+        std::vector<Source> m_sources;
+    };
+
+} // namespace slingshot
+
+#endif
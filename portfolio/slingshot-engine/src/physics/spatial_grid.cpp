@@ -0,0 +1,145 @@
+#include "physics/spatial_grid.hpp"
+#include "config/physics.hpp"
+#include "config/display.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace slingshot
+{
+
+    SpatialGrid::SpatialGrid()
+        : m_cellSize(physics::GRID_CELL_SIZE),
+          m_origin(-physics::BOUNDS_MARGIN, -physics::BOUNDS_MARGIN)
+    {
+        float width = display::WORLD_WIDTH + 2.0f * physics::BOUNDS_MARGIN;
+        float height = display::WORLD_HEIGHT + 2.0f * physics::BOUNDS_MARGIN;
+        m_columns = static_cast<int>(std::ceil(width / m_cellSize));
+        m_rows = static_cast<int>(std::ceil(height / m_cellSize));
+        m_cells.resize(static_cast<size_t>(m_columns * m_rows));
+    }
+
+    void SpatialGrid::clear()
+    {
+        for (auto &cell : m_cells)
+            cell.clear();
+        m_cellOf.clear();
+        m_slotOf.clear();
+        m_maxRadius = 0.0f;
+    }
+
+    void SpatialGrid::rebuild(const BodyStore &bodies)
+    {
+        clear();
+        addNew(bodies);
+    }
+
+    void SpatialGrid::update(const BodyStore &bodies)
+    {
+        if (bodies.size() < m_cellOf.size())
+        {
+            rebuild(bodies);
+            return;
+        }
+
+        const float *posX = bodies.posX();
+        const float *posY = bodies.posY();
+        const uint8_t *flags = bodies.flags();
+
+        for (size_t i = 0; i < m_cellOf.size(); i++)
+        {
+            if (flags[i] & body_flags::PINNED)
+                continue;
+
+            int cell = cellIndex(posX[i], posY[i]);
+            if (cell != m_cellOf[i])
+            {
+                erase(i);
+                insert(i, cell);
+            }
+        }
+
+        addNew(bodies);
+    }
+
+    void SpatialGrid::addNew(const BodyStore &bodies)
+    {
+        const float *posX = bodies.posX();
+        const float *posY = bodies.posY();
+        const float *radius = bodies.radius();
+
+        size_t known = m_cellOf.size();
+        m_cellOf.resize(bodies.size());
+        m_slotOf.resize(bodies.size());
+        for (size_t i = known; i < bodies.size(); i++)
+        {
+            insert(i, cellIndex(posX[i], posY[i]));
+            m_maxRadius = std::max(m_maxRadius, radius[i]);
+        }
+    }
+
+    void SpatialGrid::queryRadius(const BodyStore &bodies, Vec2 center, float radius, std::vector<size_t> &out) const
+    {
+        // Bodies are bucketed by centre, so widen the search by the largest radius
+        float reach = radius + m_maxRadius;
+        int minColumn = clampColumn(center.x - reach);
+        int maxColumn = clampColumn(center.x + reach);
+        int minRow = clampRow(center.y - reach);
+        int maxRow = clampRow(center.y + reach);
+
+        const float *posX = bodies.posX();
+        const float *posY = bodies.posY();
+        const float *bodyRadius = bodies.radius();
+
+        for (int row = minRow; row <= maxRow; row++)
+        {
+            for (int column = minColumn; column <= maxColumn; column++)
+            {
+                for (uint32_t i : m_cells[static_cast<size_t>(row * m_columns + column)])
+                {
+                    float dx = posX[i] - center.x;
+                    float dy = posY[i] - center.y;
+                    float minDist = radius + bodyRadius[i];
+                    if (dx * dx + dy * dy < minDist * minDist)
+                        out.push_back(i);
+                }
+            }
+        }
+    }
+
+    int SpatialGrid::cellIndex(float x, float y) const
+    {
+        return clampRow(y) * m_columns + clampColumn(x);
+    }
+
+    int SpatialGrid::clampColumn(float x) const
+    {
+        float column = std::floor((x - m_origin.x) / m_cellSize);
+        return static_cast<int>(std::min(std::max(column, 0.0f), static_cast<float>(m_columns - 1)));
+    }
+
+    int SpatialGrid::clampRow(float y) const
+    {
+        float row = std::floor((y - m_origin.y) / m_cellSize);
+        return static_cast<int>(std::min(std::max(row, 0.0f), static_cast<float>(m_rows - 1)));
+    }
+
+    void SpatialGrid::insert(size_t body, int cell)
+    {
+        auto &bucket = m_cells[static_cast<size_t>(cell)];
+        m_cellOf[body] = cell;
+        m_slotOf[body] = static_cast<uint32_t>(bucket.size());
+        bucket.push_back(static_cast<uint32_t>(body));
+    }
+
+    void SpatialGrid::erase(size_t body)
+    {
+        // Swap-remove, patching the slot of the body moved into the gap
+        auto &bucket = m_cells[static_cast<size_t>(m_cellOf[body])];
+        uint32_t slot = m_slotOf[body];
+        uint32_t last = bucket.back();
+        bucket[slot] = last;
+        m_slotOf[last] = slot;
+        bucket.pop_back();
+    }
+
+} // namespace slingshot
@@ -0,0 +1,59 @@
+#ifndef SLINGSHOT_PHYSICS_SPATIAL_GRID_HPP
+#define SLINGSHOT_PHYSICS_SPATIAL_GRID_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "math/vec2.hpp"
+#include "physics/body_store.hpp"
+
+namespace slingshot
+{
+
+    // Uniform grid over the playable area (world plus bounds margin) for
+    // broad-phase collision queries. Bodies are bucketed by centre; positions
+    // outside the area clamp to the border cells. update() only touches the
+    // buckets of bodies that changed cell since the previous call.
+    class SpatialGrid
+    {
+    public:
+        SpatialGrid();
+
+        void clear();
+        void rebuild(const BodyStore &bodies);
+
+        // Re-buckets moved bodies and appends any added since the last call.
+        // Falls back to a rebuild if bodies were removed (indices shifted).
+        // Pinned bodies are assumed to stay put; rebuild() after moving one.
+        void update(const BodyStore &bodies);
+
+        // Appends bodies added to the store since the last call, leaving the rest
+        void addNew(const BodyStore &bodies);
+
+        // Indices of bodies whose circle overlaps the query circle (exact test,
+        // appended to `out` in no particular order)
+        void queryRadius(const BodyStore &bodies, Vec2 center, float radius, std::vector<size_t> &out) const;
+
+        size_t getBodyCount() const { return m_cellOf.size(); }
+
+    private:
+        int cellIndex(float x, float y) const;
+        int clampColumn(float x) const;
+        int clampRow(float y) const;
+        void insert(size_t body, int cell);
+        void erase(size_t body);
+
+        int m_columns;
+        int m_rows;
+        float m_cellSize;
+        Vec2 m_origin;
+
+        std::vector<std::vector<uint32_t>> m_cells;
+        std::vector<int> m_cellOf;     // Cell holding each body
+        std::vector<uint32_t> m_slotOf; // Position of each body within its cell
+        float m_maxRadius = 0.0f;
+    };
+
+} // namespace slingshot
+
+#endif
@@ -2,8 +2,11 @@
 #include "entities/agent.hpp"
 #include "entities/goal.hpp"
 #include "core/renderer.hpp"
+#include "physics/collision.hpp"
 #include "config/physics.hpp"
 #include "config/display.hpp"
+#include "config/colors.hpp"
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 
@@ -20,16 +23,66 @@ namespace slingshot
         {
             m_goal = goal;
         }
+        size_t index = m_bodies.add(entity->m_body);
+        m_grid.addNew(m_bodies);
+        entity->bind(&m_bodies, index);
         m_entities.push_back(std::move(entity));
     }
 
     void PhysicsWorld::clear()
     {
         m_entities.clear();
+        m_bodies.clear();
+        m_stepStart.clear();
+        m_grid.clear();
+        m_tick = 0;
+        m_epoch++;
+        m_substepStats = SubstepStats();
         m_agent = nullptr;
         m_goal = nullptr;
     }
 
+    void PhysicsWorld::saveState(WorldState &state) const
+    {
+        m_bodies.save(state.bodies);
+        state.tick = m_tick;
+        state.epoch = m_epoch;
+        state.entityCount = m_entities.size();
+        state.hasAgent = m_agent != nullptr;
+        if (m_agent)
+            state.trail = m_agent->trail;
+        else
+            state.trail.clear();
+        state.substepStats = m_substepStats;
+    }
+
+    bool PhysicsWorld::restoreState(const WorldState &state)
+    {
+        size_t levelEntities = state.entityCount - (state.hasAgent ? 1 : 0);
+        if (state.epoch != m_epoch || m_entities.size() - (m_agent ? 1 : 0) != levelEntities)
+            return false;
+
+        if (m_agent && !state.hasAgent)
+        {
+            removeAgent();
+        }
+        else if (!m_agent && state.hasAgent)
+        {
+            addEntity(std::make_unique<Agent>(Vec2())); // Body values come from the snapshot
+        }
+
+        m_bodies.restore(state.bodies);
+        if (m_agent)
+            m_agent->trail = state.trail;
+
+        m_tick = state.tick;
+        m_substepStats = state.substepStats;
+        m_stepStart.clear();
+        m_maxStepTravel = 0.0f;
+        m_grid.rebuild(m_bodies);
+        return true;
+    }
+
     Agent *PhysicsWorld::getAgent()
     {
         return m_agent;
@@ -44,7 +97,7 @@ namespace slingshot
     {
         for (auto &entity : m_entities)
         {
-            if (entity->id == id)
+            if (entity->getId() == id)
             {
                 return entity.get();
             }
@@ -56,19 +109,19 @@ namespace slingshot
     {
         for (auto &entity : m_entities)
         {
-            if (entity->orbitsId.empty() || entity->pinned)
+            if (entity->getOrbitsId().empty() || entity->isPinned())
                 continue;
 
-            Entity *center = getEntityById(entity->orbitsId);
+            Entity *center = getEntityById(entity->getOrbitsId());
             if (!center)
             {
-                std::cerr << "Orbit target not found: " << entity->orbitsId << std::endl;
+                std::cerr << "Orbit target not found: " << entity->getOrbitsId() << std::endl;
                 continue;
             }
 
-            bool mutualOrbit = center->orbitsId == entity->id;
+            bool mutualOrbit = center->getOrbitsId() == entity->getId();
 
-            Vec2 toEntity = entity->pos - center->pos;
+            Vec2 toEntity = entity->getPos() - center->getPos();
             float distance = toEntity.magnitude();
 
             if (distance < 1e-6f)
@@ -79,18 +132,18 @@ namespace slingshot
 
             if (mutualOrbit)
             {
-                float speed = calculateOrbitalSpeed(center->mass, distance);
+                float speed = calculateOrbitalSpeed(center->getMass(), distance);
                 Vec2 tangent = toEntity.perpendicular().normalized();
-                entity->vel = tangent * speed;
+                entity->setVel(tangent * speed);
 
-                float centerSpeed = calculateOrbitalSpeed(entity->mass, distance);
-                center->vel = -tangent * centerSpeed;
+                float centerSpeed = calculateOrbitalSpeed(entity->getMass(), distance);
+                center->setVel(-tangent * centerSpeed);
             }
             else
             {
-                float speed = calculateOrbitalSpeed(center->mass, distance);
+                float speed = calculateOrbitalSpeed(center->getMass(), distance);
                 Vec2 tangent = toEntity.perpendicular().normalized();
-                entity->vel = tangent * speed;
+                entity->setVel(tangent * speed);
             }
         }
     }
@@ -100,76 +153,397 @@ namespace slingshot
         return std::sqrt(physics::G * centerMass / distance);
     }
 
-    Vec2 PhysicsWorld::calculateGravityForce(const Entity &target) const
+    bool PhysicsWorld::usesBarnesHut() const
     {
-        Vec2 totalForce(0, 0);
+        return usesBarnesHutFor(m_bodies.size());
+    }
 
-        for (const auto &source : m_entities)
+    bool PhysicsWorld::usesBarnesHutFor(size_t bodyCount) const
+    {
+        switch (m_solver)
         {
-            if (source.get() == &target)
-                continue;
-            if (!source->exertsGravity())
+        case GravitySolver::Direct:
+            return false;
+        case GravitySolver::BarnesHut:
+            return true;
+        case GravitySolver::Auto:
+            break;
+        }
+        return bodyCount >= m_barnesHutThreshold;
+    }
+
+    void PhysicsWorld::forEachBody(size_t count, const ThreadPool::RangeFn &fn)
+    {
+        if (count >= static_cast<size_t>(physics::PARALLEL_MIN_BODIES))
+            m_pool.parallelFor(count, physics::PARALLEL_GRAIN, fn);
+        else
+            fn(0, count);
+    }
+
+    void PhysicsWorld::buildQuadTree()
+    {
+        m_treeSources.clear();
+        for (size_t i = 0; i < m_sources.size(); i++)
+        {
+            m_treeSources.push_back({Vec2(m_sources.x[i], m_sources.y[i]), m_sources.mass[i], m_sources.radius[i], m_sources.index[i]});
+        }
+        m_quadTree.build(m_treeSources);
+    }
+
+    void PhysicsWorld::update(float dt)
+    {
+        // Kept for the swept contact tests against the path travelled this step
+        m_stepStart.resize(m_bodies.size());
+        for (size_t i = 0; i < m_bodies.size(); i++)
+        {
+            m_stepStart[i] = m_bodies.getPos(i);
+        }
+
+        stepBodies(m_bodies, dt);
+        m_tick++;
+
+        m_grid.update(m_bodies);
+        float maxTravelSq = 0.0f;
+        for (size_t i = 0; i < m_bodies.size(); i++)
+        {
+            maxTravelSq = std::max(maxTravelSq, m_bodies.getPos(i).distanceSquaredTo(m_stepStart[i]));
+        }
+        m_maxStepTravel = std::sqrt(maxTravelSq);
+
+        for (auto &entity : m_entities)
+        {
+            if (!entity->isPinned())
+                entity->update(dt);
+        }
+    }
+
+    void PhysicsWorld::stepBodies(BodyStore &bodies, float dt)
+    {
+        m_substepped.clear();
+        if (m_adaptiveSubstepping && !usesBarnesHutFor(bodies.size()))
+        {
+            markSubsteppedBodies(bodies, dt);
+        }
+
+        switch (m_integrator)
+        {
+        case Integrator::SemiImplicitEuler:
+            kick(bodies, dt);
+            drift(bodies, dt);
+            break;
+
+        case Integrator::VelocityVerlet:
+            // Drift-kick-drift leapfrog: one force evaluation per step
+            drift(bodies, dt * 0.5f);
+            kick(bodies, dt);
+            drift(bodies, dt * 0.5f);
+            break;
+
+        case Integrator::Yoshida4:
+        {
+            // Fourth-order Yoshida composition of three leapfrog steps
+            constexpr double CBRT2 = 1.2599210498948732;
+            constexpr float W1 = static_cast<float>(1.0 / (2.0 - CBRT2));
+            constexpr float W0 = static_cast<float>(-CBRT2 / (2.0 - CBRT2));
+            constexpr float C1 = W1 * 0.5f;
+            constexpr float C2 = (W0 + W1) * 0.5f;
+
+            drift(bodies, dt * C1);
+            kick(bodies, dt * W1);
+            drift(bodies, dt * C2);
+            kick(bodies, dt * W0);
+            drift(bodies, dt * C2);
+            kick(bodies, dt * W1);
+            drift(bodies, dt * C1);
+            break;
+        }
+        }
+
+        if (!m_substepped.empty())
+        {
+            integrateSubsteppedBodies(bodies, dt);
+        }
+
+        if (&bodies == &m_bodies)
+        {
+            uint32_t substeps = 0;
+            for (const auto &entry : m_substepped)
+                substeps += static_cast<uint32_t>(entry.second);
+
+            m_substepStats.bodies = static_cast<uint32_t>(m_substepped.size());
+            m_substepStats.substeps = substeps;
+            m_substepStats.totalBodies += m_substepStats.bodies;
+            m_substepStats.totalSubsteps += substeps;
+        }
+    }
+
+    void PhysicsWorld::markSubsteppedBodies(BodyStore &bodies, float dt)
+    {
+        m_frozenSources.gather(bodies);
+
+        const uint8_t *flags = bodies.flags();
+        const float *radius = bodies.radius();
+        m_substepCounts.assign(bodies.size(), 0);
+
+        forEachBody(bodies.size(), [&](size_t begin, size_t end)
+                    {
+            for (size_t i = begin; i < end; i++)
+            {
+                // Only test particles: sub-stepping a source would integrate the pair
+                // asymmetrically and its partner would no longer feel it consistently
+                if (!(flags[i] & body_flags::AFFECTED_BY_GRAVITY) || (flags[i] & body_flags::EXERTS_GRAVITY))
+                    continue;
+
+                Vec2 pos = bodies.getPos(i);
+                int self = static_cast<int>(i);
+
+                Vec2 accel = gravity::accelerationExcluding(m_frozenSources, pos, radius[i], self);
+                float speed = bodies.getVel(i).magnitude();
+                float travel = speed * dt + 0.5f * accel.magnitude() * dt * dt;
+
+                // Sharp turns need sub-steps even inside a source's softened core
+                float steps = speed > 0.0f ? accel.magnitude() * dt / (speed * physics::SUBSTEP_MAX_TURN) : 0.0f;
+
+                // Gap to the nearest source surface, so a fast body cannot skip past one
+                for (size_t j = 0; j < m_frozenSources.size(); j++)
+                {
+                    if (m_frozenSources.index[j] == self)
+                        continue;
+                    Vec2 sourcePos(m_frozenSources.x[j], m_frozenSources.y[j]);
+                    float gap = pos.distanceTo(sourcePos) - radius[i] - m_frozenSources.radius[j];
+                    if (gap > 0.0f)
+                        steps = std::max(steps, travel / (physics::SUBSTEP_TRAVEL_RATIO * gap));
+                }
+
+                steps = std::ceil(steps);
+                if (steps > 1.0f)
+                    m_substepCounts[i] = steps >= physics::MAX_SUBSTEPS ? physics::MAX_SUBSTEPS : static_cast<int>(steps);
+            } });
+
+        // Collected in index order, so the result does not depend on the thread count
+        for (size_t i = 0; i < bodies.size(); i++)
+        {
+            if (m_substepCounts[i] == 0)
                 continue;
+            bodies.setFlag(i, body_flags::SUBSTEPPED);
+            m_substepped.push_back({i, m_substepCounts[i]});
+        }
+    }
 
-            Vec2 direction = source->pos - target.pos;
-            float distSq = direction.magnitudeSquared();
+    void PhysicsWorld::integrateSubsteppedBodies(BodyStore &bodies, float dt)
+    {
+        // Sources move linearly from their start-of-step positions to where the
+        // main pass left them, so the sub-steps see orbiters where they really are
+        m_sources.gather(bodies);
+        m_substepSources = m_frozenSources;
 
-            float minDist = source->radius + target.radius;
-            if (distSq < minDist * minDist)
+        for (const auto &entry : m_substepped)
+        {
+            size_t i = entry.first;
+            int self = static_cast<int>(i);
+            int count = entry.second;
+            float h = dt / count;
+            float r = bodies.radius()[i];
+
+            Vec2 pos = bodies.getPos(i);
+            Vec2 vel = bodies.getVel(i);
+
+            // Leapfrog: the closing half-kick of one sub-step and the opening
+            // half-kick of the next share the sources at the boundary time
+            setSubstepSources(0.0f);
+            Vec2 accel = gravity::accelerationExcluding(m_substepSources, pos, r, self);
+            for (int k = 1; k <= count; k++)
             {
-                distSq = minDist * minDist;
+                vel += accel * (h * 0.5f);
+                pos += vel * h;
+                setSubstepSources(static_cast<float>(k) / count);
+                accel = gravity::accelerationExcluding(m_substepSources, pos, r, self);
+                vel += accel * (h * 0.5f);
             }
 
-            float forceMag = physics::G * source->mass / distSq;
-            totalForce += direction.normalized() * forceMag * target.mass;
+            bodies.setPos(i, pos);
+            bodies.setVel(i, vel);
+            bodies.clearFlag(i, body_flags::SUBSTEPPED);
         }
-
-        return totalForce;
     }
 
-    void PhysicsWorld::update(float dt)
+    void PhysicsWorld::setSubstepSources(float t)
     {
-        for (auto &entity : m_entities)
+        for (size_t j = 0; j < m_substepSources.size(); j++)
         {
-            if (!entity->isAffectedByGravity())
-                continue;
+            m_substepSources.x[j] = m_frozenSources.x[j] + (m_sources.x[j] - m_frozenSources.x[j]) * t;
+            m_substepSources.y[j] = m_frozenSources.y[j] + (m_sources.y[j] - m_frozenSources.y[j]) * t;
+        }
+    }
+
+    void PhysicsWorld::kick(BodyStore &bodies, float dt)
+    {
+        m_sources.gather(bodies);
 
-            Vec2 force = calculateGravityForce(*entity);
-            Vec2 acceleration = force / entity->mass;
-            entity->vel += acceleration * dt;
+        bool barnesHut = usesBarnesHutFor(bodies.size());
+        if (barnesHut)
+        {
+            buildQuadTree();
         }
 
-        for (auto &entity : m_entities)
+        size_t count = bodies.size();
+        const float *posX = bodies.posX();
+        const float *posY = bodies.posY();
+        float *velX = bodies.velX();
+        float *velY = bodies.velY();
+        const float *radius = bodies.radius();
+        const uint8_t *flags = bodies.flags();
+
+        // Partitioned over target bodies: each writes only its own velocity
+        forEachBody(count, [&](size_t begin, size_t end)
+                    {
+            for (size_t i = begin; i < end; i++)
+            {
+                if ((flags[i] & (body_flags::AFFECTED_BY_GRAVITY | body_flags::SUBSTEPPED)) != body_flags::AFFECTED_BY_GRAVITY)
+                    continue;
+
+                Vec2 acceleration = barnesHut
+                                        ? m_quadTree.accelerationAt(Vec2(posX[i], posY[i]), radius[i], static_cast<int>(i), m_theta)
+                                        : gravity::accelerationAt(m_sources, Vec2(posX[i], posY[i]), radius[i]);
+                velX[i] += acceleration.x * dt;
+                velY[i] += acceleration.y * dt;
+            } });
+    }
+
+    void PhysicsWorld::drift(BodyStore &bodies, float dt)
+    {
+        size_t count = bodies.size();
+        float *posX = bodies.posX();
+        float *posY = bodies.posY();
+        const float *velX = bodies.velX();
+        const float *velY = bodies.velY();
+        const uint8_t *flags = bodies.flags();
+
+        for (size_t i = 0; i < count; i++)
         {
-            if (entity->pinned)
+            if (flags[i] & (body_flags::PINNED | body_flags::SUBSTEPPED))
                 continue;
-            entity->pos += entity->vel * dt;
-            entity->update(dt);
+            posX[i] += velX[i] * dt;
+            posY[i] += velY[i] * dt;
         }
     }
 
-    bool PhysicsWorld::agentHitGravityWell() const
+    double PhysicsWorld::computeEnergy() const
     {
-        if (!m_agent)
-            return false;
+        size_t count = m_bodies.size();
+        const float *posX = m_bodies.posX();
+        const float *posY = m_bodies.posY();
+        const float *velX = m_bodies.velX();
+        const float *velY = m_bodies.velY();
+        const float *mass = m_bodies.mass();
+        const float *radius = m_bodies.radius();
+        const uint8_t *flags = m_bodies.flags();
+
+        double kinetic = 0.0;
+        double potential = 0.0;
+
+        auto pulls = [flags](size_t source, size_t target)
+        {
+            return (flags[source] & body_flags::EXERTS_GRAVITY) && (flags[target] & body_flags::AFFECTED_BY_GRAVITY);
+        };
+
+        for (size_t i = 0; i < count; i++)
+        {
+            if (!(flags[i] & body_flags::PINNED))
+            {
+                double v2 = double(velX[i]) * velX[i] + double(velY[i]) * velY[i];
+                kinetic += 0.5 * mass[i] * v2;
+            }
+
+            // Each pair once, including test particles such as the agent in a
+            // source's field; pairs of pinned bodies are constant and skipped
+            for (size_t j = i + 1; j < count; j++)
+            {
+                if ((flags[i] & flags[j] & body_flags::PINNED) || !(pulls(i, j) || pulls(j, i)))
+                    continue;
+
+                double dx = double(posX[j]) - posX[i];
+                double dy = double(posY[j]) - posY[i];
+                double r = std::sqrt(dx * dx + dy * dy);
+                double minDist = double(radius[i]) + radius[j];
+                double gmm = double(physics::G) * mass[i] * mass[j];
+
+                // Inside the softening radius the force is held constant, so the potential is linear
+                potential += r >= minDist
+                                 ? -gmm / r
+                                 : -gmm / minDist + gmm * (r - minDist) / (minDist * minDist);
+            }
+        }
+
+        return kinetic + potential;
+    }
+
+    Vec2 PhysicsWorld::stepStartPos(size_t index) const
+    {
+        // Bodies added since the last update have not moved yet
+        return index < m_stepStart.size() ? m_stepStart[index] : m_bodies.getPos(index);
+    }
+
+    float PhysicsWorld::agentContactTime(size_t index, float reach) const
+    {
+        size_t agent = m_agent->getIndex();
+        return collision::contactTime(stepStartPos(agent), m_bodies.getPos(agent),
+                                      stepStartPos(index), m_bodies.getPos(index), reach);
+    }
 
-        for (const auto &entity : m_entities)
+    float PhysicsWorld::firstGravityWellContact() const
+    {
+        // Broad phase: anything that can touch the agent's path this step lies
+        // within half the path plus the farthest any body moved of its midpoint
+        size_t agent = m_agent->getIndex();
+        Vec2 start = stepStartPos(agent);
+        Vec2 end = m_bodies.getPos(agent);
+        float reach = 0.5f * start.distanceTo(end) + m_agent->getRadius() + m_maxStepTravel;
+
+        m_nearby.clear();
+        m_grid.queryRadius(m_bodies, Vec2::lerp(start, end, 0.5f), reach, m_nearby);
+
+        float first = collision::NO_CONTACT;
+        for (size_t index : m_nearby)
         {
-            if (entity.get() == m_agent || entity.get() == m_goal)
+            const Entity *entity = m_entities[index].get();
+            if (entity == m_agent || entity == m_goal)
                 continue;
-            if (m_agent->collidesWith(*entity))
+            float t = agentContactTime(index, m_agent->getRadius() + entity->getRadius());
+            if (collision::isFirstContact(t, first))
             {
-                return true;
+                first = t;
             }
         }
-        return false;
+        return first;
+    }
+
+    float PhysicsWorld::goalContact() const
+    {
+        return agentContactTime(m_goal->getIndex(), m_goal->getRadius());
+    }
+
+    void PhysicsWorld::queryRadius(Vec2 center, float radius, std::vector<size_t> &out) const
+    {
+        m_grid.queryRadius(m_bodies, center, radius, out);
+    }
+
+    bool PhysicsWorld::agentHitGravityWell() const
+    {
+        if (!m_agent)
+            return false;
+
+        float well = firstGravityWellContact();
+        if (well == collision::NO_CONTACT)
+            return false;
+        return !m_goal || !collision::isFirstContact(goalContact(), well);
     }
 
     bool PhysicsWorld::agentReachedGoal() const
     {
         if (!m_agent || !m_goal)
             return false;
-        return m_goal->contains(m_agent->pos);
+        return collision::isFirstContact(goalContact(), firstGravityWellContact());
     }
 
     bool PhysicsWorld::agentOutOfBounds() const
@@ -178,18 +552,85 @@ namespace slingshot
             return false;
 
         float margin = physics::BOUNDS_MARGIN;
-        return m_agent->pos.x < -margin ||
-               m_agent->pos.x > display::WORLD_WIDTH + margin ||
-               m_agent->pos.y < -margin ||
-               m_agent->pos.y > display::WORLD_HEIGHT + margin;
+        Vec2 pos = m_agent->getPos();
+        return pos.x < -margin ||
+               pos.x > display::WORLD_WIDTH + margin ||
+               pos.y < -margin ||
+               pos.y > display::WORLD_HEIGHT + margin;
+    }
+
+    void PhysicsWorld::render(Renderer &renderer, float alpha) const
+    {
+        renderStatic(renderer);
+
+        if (m_agent)
+            renderer.drawTrail(m_agent->trail, colors::entity::AGENT_TRAIL);
+
+        // Moving bodies are drawn between their last two steps
+        for (size_t i = 0; i < m_entities.size(); i++)
+        {
+            if (!m_entities[i]->isPinned())
+                m_entities[i]->draw(renderer, Vec2::lerp(stepStartPos(i), m_bodies.getPos(i), alpha));
+        }
+    }
+
+    void PhysicsWorld::render(Renderer &renderer, const WorldSnapshot &snapshot, float alpha) const
+    {
+        renderStatic(renderer);
+
+        if (m_agent)
+            renderer.drawTrail(snapshot.trail, colors::entity::AGENT_TRAIL);
+
+        size_t count = std::min(snapshot.positions.size(), m_entities.size());
+        for (size_t i = 0; i < count; i++)
+        {
+            if (!m_entities[i]->isPinned())
+                m_entities[i]->draw(renderer, Vec2::lerp(snapshot.previous[i], snapshot.positions[i], alpha));
+        }
+    }
+
+    void PhysicsWorld::renderStatic(Renderer &renderer) const
+    {
+        // Pinned bodies never move, so they go in the renderer's static layer
+        if (renderer.beginStaticLayer())
+        {
+            for (const auto &entity : m_entities)
+            {
+                if (entity->isPinned())
+                    entity->render(renderer);
+            }
+            renderer.endStaticLayer();
+        }
     }
 
-    void PhysicsWorld::render(Renderer &renderer) const
+    void PhysicsWorld::captureSnapshot(WorldSnapshot &snapshot) const
     {
-        for (const auto &entity : m_entities)
+        size_t count = m_bodies.size();
+        snapshot.tick = m_tick;
+        snapshot.positions.resize(count);
+        snapshot.previous.resize(count);
+        for (size_t i = 0; i < count; i++)
         {
-            entity->render(renderer);
+            snapshot.positions[i] = m_bodies.getPos(i);
+            snapshot.previous[i] = stepStartPos(i);
         }
+
+        if (m_agent)
+            snapshot.trail = m_agent->trail;
+        else
+            snapshot.trail.clear();
+        snapshot.outcome = checkAgent();
+    }
+
+    AgentOutcome PhysicsWorld::checkAgent() const
+    {
+        if (agentReachedGoal())
+            return AgentOutcome::ReachedGoal;
+        if (agentHitGravityWell())
+            return AgentOutcome::HitGravityWell;
+        if (agentOutOfBounds())
+            return AgentOutcome::OutOfBounds;
+        return AgentOutcome::None;
     }
 
     void PhysicsWorld::removeAgent()
@@ -197,14 +638,17 @@ namespace slingshot
         if (!m_agent)
             return;
 
-        m_entities.erase(
-            std::remove_if(m_entities.begin(), m_entities.end(),
-                           [this](const std::unique_ptr<Entity> &e)
-                           {
-                               return e.get() == m_agent;
-                           }),
-            m_entities.end());
+        size_t index = m_agent->getIndex();
+        m_bodies.remove(index);
+        m_entities.erase(m_entities.begin() + index);
+        m_stepStart.clear();
+        m_grid.rebuild(m_bodies);
         m_agent = nullptr;
+
+        for (size_t i = index; i < m_entities.size(); i++)
+        {
+            m_entities[i]->bind(&m_bodies, i);
+        }
     }
 
 } // namespace slingshot
@@ -1,11 +1,20 @@
 #ifndef SLINGSHOT_PHYSICS_WORLD_HPP
 #define SLINGSHOT_PHYSICS_WORLD_HPP
 
+#include <cstdint>
 #include <vector>
 #include <memory>
 #include <string>
+#include <utility>
 #include "entities/entity.hpp"
 #include "math/vec2.hpp"
+#include "physics/quadtree.hpp"
+#include "physics/body_store.hpp"
+#include "physics/gravity_kernel.hpp"
+#include "physics/spatial_grid.hpp"
+#include "physics/world_snapshot.hpp"
+#include "core/thread_pool.hpp"
+#include "config/physics.hpp"
 
 namespace slingshot
 {
@@ -14,10 +23,48 @@ namespace slingshot
     class Goal;
     class Renderer;
 
+    enum class GravitySolver
+    {
+        Direct,    // Exact O(n^2) pairwise sum
+        BarnesHut, // O(n log n) quadtree approximation
+        Auto       // Direct below the Barnes-Hut threshold, quadtree above it
+    };
+
+    enum class Integrator
+    {
+        SemiImplicitEuler, // One force evaluation per step, drifts energy on orbits
+        VelocityVerlet,    // Symplectic drift-kick-drift leapfrog, second order, one force evaluation
+        Yoshida4           // Symplectic fourth order, three force evaluations per step
+    };
+
+    // Sub-stepping counters: per last update() and cumulative since clear()
+    struct SubstepStats
+    {
+        uint32_t bodies = 0;
+        uint32_t substeps = 0;
+        uint64_t totalBodies = 0;
+        uint64_t totalSubsteps = 0;
+    };
+
+    // Everything update() advances, captured so the world can be put back
+    // exactly (retries, rollback). Only valid for the level it was saved from.
+    struct WorldState
+    {
+        BodyStore::Snapshot bodies;
+        uint64_t tick = 0;
+        uint64_t epoch = 0;    // PhysicsWorld::clear() count at the save
+        size_t entityCount = 0;
+        bool hasAgent = false; // The agent is always the last entity
+        Trail trail;
+        SubstepStats substepStats;
+    };
+
     class PhysicsWorld
     {
     public:
         PhysicsWorld() = default;
+        PhysicsWorld(const PhysicsWorld &) = delete;
+        PhysicsWorld &operator=(const PhysicsWorld &) = delete;
 
         void addEntity(std::unique_ptr<Entity> entity);
         void clear();
@@ -25,26 +72,119 @@ namespace slingshot
         void initializeOrbits();
         void update(float dt);
 
+        // Advance a detached body store (e.g. a prediction copy) with this world's solver settings
+        void stepBodies(BodyStore &bodies, float dt);
+
+        // Number of update() steps since the world was last cleared
+        uint64_t getTick() const { return m_tick; }
+
+        // Restoring drops an agent spawned since the save, or respawns one
+        // removed since. Fails if the world was cleared in between.
+        void saveState(WorldState &state) const;
+        bool restoreState(const WorldState &state);
+
+        // Tick and body state folded into one value, for comparing runs
+        // across builds (see SLINGSHOT_DETERMINISTIC)
+        uint64_t hashState() const { return m_bodies.hashState() ^ (m_tick * 0x9E3779B97F4A7C15ull); }
+
+        void setGravitySolver(GravitySolver solver) { m_solver = solver; }
+        GravitySolver getGravitySolver() const { return m_solver; }
+        void setBarnesHutTheta(float theta) { m_theta = theta; }
+        float getBarnesHutTheta() const { return m_theta; }
+        void setBarnesHutThreshold(size_t bodyCount) { m_barnesHutThreshold = bodyCount; }
+        bool usesBarnesHut() const;
+
+        void setIntegrator(Integrator integrator) { m_integrator = integrator; }
+        Integrator getIntegrator() const { return m_integrator; }
+
+        // Sub-step bodies in close encounters instead of shrinking the global step
+        void setAdaptiveSubstepping(bool enabled) { m_adaptiveSubstepping = enabled; }
+        bool getAdaptiveSubstepping() const { return m_adaptiveSubstepping; }
+        const SubstepStats &getSubstepStats() const { return m_substepStats; }
+
+        // Threads (including the caller) used for force evaluation in worlds of
+        // at least PARALLEL_MIN_BODIES bodies. Results do not depend on it.
+        void setThreadCount(int threads) { m_pool.setThreadCount(threads); }
+        int getThreadCount() const { return m_pool.getThreadCount(); }
+
+        // Kinetic energy of the moving bodies plus the potential of every pair that
+        // interacts, in either direction (for drift diagnostics)
+        double computeEnergy() const;
+
         Agent *getAgent();
         Goal *getGoal();
         Entity *getEntityById(const std::string &id);
         const std::vector<std::unique_ptr<Entity>> &getEntities() const { return m_entities; }
+        const BodyStore &getBodies() const { return m_bodies; }
+
+        // Appends the indices (into getBodies() and getEntities()) of bodies whose
+        // circle overlaps the given one, from the broad-phase grid
+        void queryRadius(Vec2 center, float radius, std::vector<size_t> &out) const;
 
+        // Swept over the path travelled during the last update, so a fast agent
+        // cannot skip past a body between frames; whichever is touched first wins
         bool agentHitGravityWell() const;
         bool agentReachedGoal() const;
         bool agentOutOfBounds() const;
 
-        void render(Renderer &renderer) const;
+        // The first of the above that holds, in the order the game checks them
+        AgentOutcome checkAgent() const;
+
+        // alpha in [0, 1] places moving bodies between their positions before
+        // and after the last update(), for fixed-step render interpolation
+        void render(Renderer &renderer, float alpha = 1.0f) const;
+
+        // Same, with moving bodies and the trail taken from a snapshot, so the
+        // world can be stepped on another thread meanwhile. Only pinned bodies
+        // (which stepping never writes) are read from the live world.
+        void render(Renderer &renderer, const WorldSnapshot &snapshot, float alpha) const;
+        void captureSnapshot(WorldSnapshot &snapshot) const;
 
         void removeAgent();
 
     private:
-        Vec2 calculateGravityForce(const Entity &target) const;
         float calculateOrbitalSpeed(float centerMass, float distance) const;
+        void markSubsteppedBodies(BodyStore &bodies, float dt);
+        void integrateSubsteppedBodies(BodyStore &bodies, float dt);
+        void setSubstepSources(float t);
+        void kick(BodyStore &bodies, float dt);
+        void drift(BodyStore &bodies, float dt);
+        bool usesBarnesHutFor(size_t bodyCount) const;
+        void forEachBody(size_t count, const ThreadPool::RangeFn &fn);
+        void buildQuadTree();
+        void renderStatic(Renderer &renderer) const;
+        Vec2 stepStartPos(size_t index) const;
+        float agentContactTime(size_t index, float reach) const;
+        float firstGravityWellContact() const;
+        float goalContact() const;
 
+        // Authoritative simulation state; m_entities[i] is a view over body i
+        BodyStore m_bodies;
         std::vector<std::unique_ptr<Entity>> m_entities;
         Agent *m_agent = nullptr;
         Goal *m_goal = nullptr;
+        uint64_t m_tick = 0;
+        uint64_t m_epoch = 0;
+        std::vector<Vec2> m_stepStart; // Body positions before the last update
+        float m_maxStepTravel = 0.0f;  // Farthest any body moved in the last update
+        SpatialGrid m_grid;
+        mutable std::vector<size_t> m_nearby; // Scratch for broad-phase queries
+
+        Integrator m_integrator = Integrator::VelocityVerlet;
+        GravitySolver m_solver = GravitySolver::Auto;
+        float m_theta = physics::BARNES_HUT_THETA;
+        size_t m_barnesHutThreshold = physics::BARNES_HUT_THRESHOLD;
+        bool m_adaptiveSubstepping = true;
+        SubstepStats m_substepStats;
+        GravitySources m_frozenSources;  // Sources at the start of the step, for sub-stepped bodies
+        GravitySources m_substepSources; // Sources interpolated to the current sub-step time
+        std::vector<std::pair<size_t, int>> m_substepped; // (body index, sub-step count)
+        std::vector<int> m_substepCounts;                 // Per body, filled in parallel
+
+        GravitySources m_sources;
+        QuadTree m_quadTree;
+        std::vector<QuadTree::Source> m_treeSources;
+        ThreadPool m_pool;
     };
 
 } // namespace slingshot
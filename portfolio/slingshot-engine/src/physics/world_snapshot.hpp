@@ -0,0 +1,34 @@
+#ifndef SLINGSHOT_PHYSICS_WORLD_SNAPSHOT_HPP
+#define SLINGSHOT_PHYSICS_WORLD_SNAPSHOT_HPP
+
+#include <cstdint>
+#include <vector>
+#include "core/renderer.hpp"
+#include "math/vec2.hpp"
+
+namespace slingshot
+{
+
+    // How the agent's flight ended on the last step, if it did
+    enum class AgentOutcome
+    {
+        None,
+        ReachedGoal,
+        HitGravityWell,
+        OutOfBounds
+    };
+
+    // Everything the renderer needs from a PhysicsWorld, copied out so a
+    // render thread can draw while another thread keeps stepping the world
+    struct WorldSnapshot
+    {
+        uint64_t tick = 0;
+        std::vector<Vec2> positions; // Per body, after the last step
+        std::vector<Vec2> previous;  // Per body, before the last step
+        Trail trail;                 // Agent trail (empty without an agent)
+        AgentOutcome outcome = AgentOutcome::None;
+    };
+
+} // namespace slingshot
+
+#endif
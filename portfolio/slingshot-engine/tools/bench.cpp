@@ -0,0 +1,543 @@
+// Physics benchmark suite for the headless core.
+//
+// Usage: slingshot_bench [--filter=SUBSTR] [--min-time=SECONDS] [--json=FILE] [--levels=DIR] [--compiled-levels=DIR]
+//
+// Prints a table to stdout; --json writes results in Google Benchmark's JSON
+// layout so existing comparison tooling can diff runs.
+
+#include "physics/world.hpp"
+#include "game/level_loader.hpp"
+#include "game/level_binary.hpp"
+#include "game/level_pack.hpp"
+#include "game/replay.hpp"
+#include "entities/agent.hpp"
+#include "entities/asteroid.hpp"
+#include "entities/goal.hpp"
+#include "entities/sun.hpp"
+#include "config/physics.hpp"
+#include "config/display.hpp"
+#include "lib/json.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#ifndef SLINGSHOT_LEVELS_DIR
+#define SLINGSHOT_LEVELS_DIR "levels"
+#endif
+
+#ifndef SLINGSHOT_COMPILED_LEVELS_DIR
+#define SLINGSHOT_COMPILED_LEVELS_DIR "build/levels"
+#endif
+
+namespace
+{
+    using namespace slingshot;
+    using Clock = std::chrono::steady_clock;
+
+    struct Options
+    {
+        std::string filter;
+        std::string jsonPath;
+        std::string levelsDir = SLINGSHOT_LEVELS_DIR;
+        std::string compiledLevelsDir = SLINGSHOT_COMPILED_LEVELS_DIR;
+        double minTime = 0.25;
+    };
+
+    // Results of queries with no side effects are folded into a count and
+    // stored here once per run, so the loop computing them cannot be dropped
+    volatile uint64_t g_sink = 0;
+
+    // A benchmark runs `iterations` repetitions of its operation. Setup happens
+    // when the benchmark is registered, outside the timed region.
+    struct Benchmark
+    {
+        std::string name;
+        std::function<void(uint64_t iterations)> run;
+        double bodiesPerIteration = 0.0; // Enables the ns/body/step counter
+    };
+
+    struct Result
+    {
+        std::string name;
+        uint64_t iterations = 0;
+        double nsPerIteration = 0.0;
+        std::map<std::string, double> counters;
+    };
+
+    std::string levelPath(const Options &options, int levelId)
+    {
+        return LevelLoader::path(options.levelsDir, levelId);
+    }
+
+    std::vector<int> findLevels(const Options &options)
+    {
+        std::vector<int> ids;
+        for (int i = 1; i <= LevelLoader::MAX_LEVELS; ++i)
+        {
+            std::ifstream file(levelPath(options, i));
+            if (!file.good())
+                break;
+            ids.push_back(i);
+        }
+        return ids;
+    }
+
+    // Free-floating asteroid field around a pinned sun, seeded for repeatability
+    void buildSyntheticWorld(PhysicsWorld &world, int bodyCount)
+    {
+        std::mt19937 rng(1234);
+        std::uniform_real_distribution<float> x(0.0f, display::WORLD_WIDTH);
+        std::uniform_real_distribution<float> y(0.0f, display::WORLD_HEIGHT);
+
+        world.addEntity(std::make_unique<Sun>(Vec2(display::WORLD_WIDTH / 2, display::WORLD_HEIGHT / 2)));
+        for (int i = 1; i < bodyCount; i++)
+        {
+            world.addEntity(std::make_unique<Asteroid>(Vec2(x(rng), y(rng)), false));
+        }
+    }
+
+    // Ring of asteroids orbiting a pinned sun (exercises initializeOrbits)
+    void buildOrbitWorld(PhysicsWorld &world, int bodyCount)
+    {
+        Vec2 center(display::WORLD_WIDTH / 2, display::WORLD_HEIGHT / 2);
+        world.addEntity(std::make_unique<Sun>(center, true, "center"));
+        for (int i = 1; i < bodyCount; i++)
+        {
+            float angle = 6.2831853f * i / bodyCount;
+            float distance = 150.0f + 5.0f * (i % 50);
+            auto asteroid = std::make_unique<Asteroid>(center + Vec2(distance, 0.0f).rotated(angle), false);
+            asteroid->setOrbitsId("center");
+            world.addEntity(std::move(asteroid));
+        }
+    }
+
+    Result runBenchmark(const Benchmark &bench, double minTime)
+    {
+        uint64_t iterations = 1;
+        double elapsed = 0.0;
+
+        while (true)
+        {
+            auto start = Clock::now();
+            bench.run(iterations);
+            elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+
+            if (elapsed >= minTime || iterations >= (1ull << 40))
+                break;
+
+            // Aim straight for the target time once we have a usable estimate
+            double scale = elapsed > 1e-6 ? (minTime * 1.4) / elapsed : 10.0;
+            uint64_t next = static_cast<uint64_t>(iterations * std::min(std::max(scale, 2.0), 100.0));
+            iterations = std::max(next, iterations + 1);
+        }
+
+        Result result;
+        result.name = bench.name;
+        result.iterations = iterations;
+        result.nsPerIteration = elapsed * 1e9 / iterations;
+        result.counters["items_per_second"] = iterations / elapsed;
+        if (bench.bodiesPerIteration > 0.0)
+        {
+            result.counters["ns_per_body_step"] = result.nsPerIteration / bench.bodiesPerIteration;
+        }
+        return result;
+    }
+
+    void addStepBenchmark(std::vector<Benchmark> &benches, const std::string &name, std::shared_ptr<PhysicsWorld> world)
+    {
+        double bodies = static_cast<double>(world->getBodies().size());
+        benches.push_back({name,
+                           [world](uint64_t iterations)
+                           {
+                               for (uint64_t i = 0; i < iterations; i++)
+                                   world->update(physics::TIME_STEP);
+                           },
+                           bodies});
+    }
+
+    std::vector<Benchmark> registerBenchmarks(const Options &options)
+    {
+        std::vector<Benchmark> benches;
+        std::vector<int> levels = findLevels(options);
+
+        // PhysicsWorld::update on every shipped level
+        for (int id : levels)
+        {
+            auto world = std::make_shared<PhysicsWorld>();
+            LevelData data;
+            if (!LevelLoader::load(levelPath(options, id), *world, data))
+                continue;
+            char name[48];
+            std::snprintf(name, sizeof(name), "WorldUpdate/level_%02d", id);
+            addStepBenchmark(benches, name, world);
+        }
+
+        // PhysicsWorld::update on synthetic worlds, per gravity solver
+        for (int count : {10, 100, 1000, 10000})
+        {
+            const std::pair<const char *, GravitySolver> solvers[] = {
+                {"direct", GravitySolver::Direct},
+                {"barnes_hut", GravitySolver::BarnesHut}};
+            for (const auto &solver : solvers)
+            {
+                auto world = std::make_shared<PhysicsWorld>();
+                buildSyntheticWorld(*world, count);
+                world->setGravitySolver(solver.second);
+                addStepBenchmark(benches, "WorldUpdate/synthetic/" + std::string(solver.first) + "/" + std::to_string(count), world);
+            }
+        }
+
+        // Thread scaling of the force evaluation, on a direct-sum world below the
+        // Barnes-Hut threshold and a quadtree world above it
+        for (int threads : {1, 2, 4, 8})
+        {
+            const std::pair<const char *, int> worlds[] = {{"direct", 2000}, {"barnes_hut", 10000}};
+            for (const auto &entry : worlds)
+            {
+                auto world = std::make_shared<PhysicsWorld>();
+                buildSyntheticWorld(*world, entry.second);
+                world->setThreadCount(threads);
+                addStepBenchmark(benches, "WorldUpdate/threads/" + std::string(entry.first) + "/" +
+                                              std::to_string(entry.second) + "/" + std::to_string(threads),
+                                 world);
+            }
+        }
+
+        // Agent contact queries (broad-phase grid + swept narrow phase) after one step
+        for (int count : {100, 1000, 10000})
+        {
+            auto world = std::make_shared<PhysicsWorld>();
+            buildSyntheticWorld(*world, count);
+            world->addEntity(std::make_unique<Goal>(Vec2(display::WORLD_WIDTH - 100.0f, 100.0f)));
+            world->addEntity(std::make_unique<Agent>(Vec2(100.0f, display::WORLD_HEIGHT - 100.0f)));
+            world->getAgent()->setVel(Vec2(400.0f, -200.0f));
+            world->update(physics::TIME_STEP);
+            benches.push_back({"AgentCollision/" + std::to_string(count),
+                               [world](uint64_t iterations)
+                               {
+                                   uint64_t ended = 0;
+                                   for (uint64_t i = 0; i < iterations; i++)
+                                       ended += world->agentReachedGoal() || world->agentHitGravityWell();
+                                   g_sink = ended;
+                               }});
+        }
+
+        // LevelLoader::load latency (file read + JSON parse + entity creation)
+        for (int id : levels)
+        {
+            std::string path = levelPath(options, id);
+            auto world = std::make_shared<PhysicsWorld>();
+            char name[48];
+            std::snprintf(name, sizeof(name), "LevelLoad/level_%02d", id);
+            benches.push_back({name,
+                               [path, world](uint64_t iterations)
+                               {
+                                   LevelData data;
+                                   for (uint64_t i = 0; i < iterations; i++)
+                                   {
+                                       world->clear();
+                                       LevelLoader::load(path, *world, data);
+                                   }
+                               }});
+        }
+
+        // level_binary::load latency on the same levels compiled by slingshot_levelc
+        for (int id : levels)
+        {
+            char file[32];
+            std::snprintf(file, sizeof(file), "level_%02d%s", id, level_binary::FILE_EXTENSION);
+            std::string path = options.compiledLevelsDir + "/" + file;
+            if (!std::ifstream(path).good())
+                continue;
+
+            auto world = std::make_shared<PhysicsWorld>();
+            char name[48];
+            std::snprintf(name, sizeof(name), "LevelLoad/binary/level_%02d", id);
+            benches.push_back({name,
+                               [path, world](uint64_t iterations)
+                               {
+                                   LevelData data;
+                                   for (uint64_t i = 0; i < iterations; i++)
+                                   {
+                                       world->clear();
+                                       level_binary::load(path, *world, data);
+                                   }
+                               }});
+        }
+
+        // LevelPack::load from the parsed-level cache (what a reset costs in game)
+        auto pack = std::make_shared<LevelPack>();
+        if (pack->open(options.compiledLevelsDir + "/" + LevelPack::FILE_NAME))
+        {
+            for (int id : pack->getLevelIds())
+            {
+                auto world = std::make_shared<PhysicsWorld>();
+                char name[48];
+                std::snprintf(name, sizeof(name), "LevelLoad/pack/level_%02d", id);
+                benches.push_back({name,
+                                   [pack, id, world](uint64_t iterations)
+                                   {
+                                       LevelData data;
+                                       for (uint64_t i = 0; i < iterations; i++)
+                                       {
+                                           world->clear();
+                                           pack->load(id, *world, data);
+                                       }
+                                   }});
+            }
+        }
+
+        // ReplayPlayer::play on a one-launch replay: a second of aiming, then
+        // up to ten seconds of flight (what the verifier pays per attempt)
+        for (int id : levels)
+        {
+            auto level = std::make_shared<LevelDefinition>();
+            if (!LevelLoader::read(levelPath(options, id), *level))
+                continue;
+
+            PhysicsWorld world;
+            ReplayRecorder recorder;
+            level->build(world);
+            recorder.begin(id);
+            for (int i = 0; i < 60; i++)
+                world.update(physics::TIME_STEP);
+            recorder.recordLaunch(world, Vec2(400.0f, -250.0f));
+            world.addEntity(std::make_unique<Agent>(level->info.spawn));
+            world.getAgent()->setVel(Vec2(400.0f, -250.0f));
+            AgentOutcome outcome = AgentOutcome::None;
+            for (int i = 0; i < 600 && outcome == AgentOutcome::None; i++)
+            {
+                world.update(physics::TIME_STEP);
+                outcome = world.checkAgent();
+            }
+            recorder.recordEnd(world, outcome);
+
+            auto replay = std::make_shared<Replay>(recorder.getReplay());
+            auto player = std::make_shared<ReplayPlayer>();
+            char name[48];
+            std::snprintf(name, sizeof(name), "ReplayPlay/level_%02d", id);
+            benches.push_back({name,
+                               [level, replay, player](uint64_t iterations)
+                               {
+                                   ReplayResult result;
+                                   for (uint64_t i = 0; i < iterations; i++)
+                                       player->play(*level, *replay, result);
+                               }});
+        }
+
+        // PhysicsWorld::initializeOrbits (idempotent, so it can be repeated in place)
+        for (int count : {10, 100, 1000})
+        {
+            auto world = std::make_shared<PhysicsWorld>();
+            buildOrbitWorld(*world, count);
+            benches.push_back({"InitializeOrbits/" + std::to_string(count),
+                               [world](uint64_t iterations)
+                               {
+                                   for (uint64_t i = 0; i < iterations; i++)
+                                       world->initializeOrbits();
+                               }});
+        }
+
+        return benches;
+    }
+
+    // Simulates one minute of game time and records the worst relative energy
+    // error. Only the update() calls are timed.
+    Result runEnergyDrift(const std::string &name, const std::string &path, Integrator integrator, int dtScale)
+    {
+        PhysicsWorld world;
+        LevelData data;
+        LevelLoader::load(path, world, data);
+        world.setIntegrator(integrator);
+
+        float dt = physics::TIME_STEP * dtScale;
+        uint64_t steps = static_cast<uint64_t>(60.0f / dt);
+        double initial = world.computeEnergy();
+        double maxDrift = 0.0;
+        double elapsed = 0.0;
+
+        for (uint64_t i = 0; i < steps; i++)
+        {
+            auto start = Clock::now();
+            world.update(dt);
+            elapsed += std::chrono::duration<double>(Clock::now() - start).count();
+
+            double drift = std::abs((world.computeEnergy() - initial) / initial);
+            maxDrift = std::max(maxDrift, drift);
+        }
+
+        Result result;
+        result.name = name;
+        result.iterations = steps;
+        result.nsPerIteration = elapsed * 1e9 / steps;
+        result.counters["items_per_second"] = steps / elapsed;
+        result.counters["max_relative_energy_drift"] = maxDrift;
+        return result;
+    }
+
+    bool hasMovingBodies(const std::string &path)
+    {
+        PhysicsWorld world;
+        LevelData data;
+        if (!LevelLoader::load(path, world, data))
+            return false;
+        for (const auto &entity : world.getEntities())
+        {
+            if (!entity->isPinned())
+                return true;
+        }
+        return false;
+    }
+
+    bool parseArgs(int argc, char **argv, Options &options)
+    {
+        for (int i = 1; i < argc; i++)
+        {
+            std::string arg = argv[i];
+            auto value = [&arg](const char *prefix) -> const char *
+            {
+                size_t len = std::char_traits<char>::length(prefix);
+                return arg.compare(0, len, prefix) == 0 ? arg.c_str() + len : nullptr;
+            };
+
+            if (const char *v = value("--filter="))
+                options.filter = v;
+            else if (const char *v = value("--json="))
+                options.jsonPath = v;
+            else if (const char *v = value("--levels="))
+                options.levelsDir = v;
+            else if (const char *v = value("--compiled-levels="))
+                options.compiledLevelsDir = v;
+            else if (const char *v = value("--min-time="))
+                options.minTime = std::atof(v);
+            else
+            {
+                std::cerr << "Unknown argument: " << arg << std::endl;
+                std::cerr << "Usage: slingshot_bench [--filter=SUBSTR] [--min-time=SECONDS] [--json=FILE] [--levels=DIR] [--compiled-levels=DIR]" << std::endl;
+                return false;
+            }
+        }
+        return true;
+    }
+
+    nlohmann::json toJson(const std::vector<Result> &results)
+    {
+        nlohmann::json benchmarks = nlohmann::json::array();
+        for (const auto &r : results)
+        {
+            nlohmann::json entry = {
+                {"name", r.name},
+                {"run_name", r.name},
+                {"run_type", "iteration"},
+                {"iterations", r.iterations},
+                {"real_time", r.nsPerIteration},
+                {"cpu_time", r.nsPerIteration},
+                {"time_unit", "ns"}};
+            for (const auto &counter : r.counters)
+            {
+                entry[counter.first] = counter.second;
+            }
+            benchmarks.push_back(entry);
+        }
+
+        char date[32];
+        std::time_t now = std::time(nullptr);
+        std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+        return {
+            {"context", {{"date", date},
+                         {"executable", "slingshot_bench"},
+                         {"gravity_kernel", gravity::kernelName()},
+                         {"deterministic", physics::DETERMINISTIC},
+                         {"num_cpus", ThreadPool::hardwareThreads()}}},
+            {"benchmarks", benchmarks}};
+    }
+}
+
+int main(int argc, char **argv)
+{
+    Options options;
+    if (!parseArgs(argc, argv, options))
+        return 1;
+
+    std::vector<Result> results;
+    std::printf("%-44s %14s %12s %14s %16s\n", "Benchmark", "Time (ns)", "Iterations", "Per second", "ns/body/step");
+
+    for (const auto &bench : registerBenchmarks(options))
+    {
+        if (!options.filter.empty() && bench.name.find(options.filter) == std::string::npos)
+            continue;
+
+        Result r = runBenchmark(bench, options.minTime);
+        auto body = r.counters.find("ns_per_body_step");
+        std::printf("%-44s %14.1f %12llu %14.1f %16s\n",
+                    r.name.c_str(), r.nsPerIteration,
+                    static_cast<unsigned long long>(r.iterations),
+                    r.counters["items_per_second"],
+                    body != r.counters.end() ? std::to_string(body->second).c_str() : "-");
+        results.push_back(r);
+    }
+
+    // Energy drift per integrator and timestep on the levels with orbiting bodies
+    const std::pair<const char *, Integrator> integrators[] = {
+        {"euler", Integrator::SemiImplicitEuler},
+        {"verlet", Integrator::VelocityVerlet},
+        {"yoshida4", Integrator::Yoshida4}};
+    bool driftHeader = false;
+
+    for (int id : findLevels(options))
+    {
+        std::string path = levelPath(options, id);
+        if (!hasMovingBodies(path))
+            continue;
+
+        for (const auto &integrator : integrators)
+        {
+            for (int dtScale : {1, 4})
+            {
+                char name[64];
+                std::snprintf(name, sizeof(name), "EnergyDrift/%s/dt_x%d/level_%02d", integrator.first, dtScale, id);
+                if (!options.filter.empty() && std::string(name).find(options.filter) == std::string::npos)
+                    continue;
+
+                if (!driftHeader)
+                {
+                    std::printf("\n%-44s %14s %12s %14s %16s\n", "Benchmark", "Time (ns)", "Steps", "Per second", "Max drift");
+                    driftHeader = true;
+                }
+
+                Result r = runEnergyDrift(name, path, integrator.second, dtScale);
+                std::printf("%-44s %14.1f %12llu %14.1f %16.3e\n",
+                            r.name.c_str(), r.nsPerIteration,
+                            static_cast<unsigned long long>(r.iterations),
+                            r.counters["items_per_second"],
+                            r.counters["max_relative_energy_drift"]);
+                results.push_back(r);
+            }
+        }
+    }
+
+    if (!options.jsonPath.empty())
+    {
+        std::ofstream out(options.jsonPath);
+        if (!out)
+        {
+            std::cerr << "Cannot write " << options.jsonPath << std::endl;
+            return 1;
+        }
+        out << toJson(results).dump(2) << std::endl;
+    }
+
+    return 0;
+}
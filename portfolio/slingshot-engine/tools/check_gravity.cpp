@@ -0,0 +1,337 @@
+// Gravity solver checks: compares the fast paths of the force evaluation with
+// their references on real worlds, so a change to the tree, the default
+// opening angle or the vector kernel cannot quietly make the physics wrong.
+//
+// Usage: slingshot_check_gravity LEVEL.json...
+//
+// Barnes-Hut: each level is built as the game builds it, plus one synthetic
+// world of BARNES_HUT_THRESHOLD bodies (the smallest the game steps with the
+// tree). Accelerations from the tree at the default theta are compared with
+// the direct sum at every body affected by gravity and on a grid of
+// agent-sized probes across the screen; each world's worst error must stay
+// within BARNES_HUT_MAX_ERROR.
+//
+// Vector kernel: gravity::accelerationAt() is compared with the scalar
+// reference on the same levels and probes, and on random worlds of every
+// size around the lane width with probes on and around each source's
+// softening radius. The two differ only in summation order, so each
+// component must agree within KERNEL_ULPS_PER_ROOT_SOURCE * sqrt(sources)
+// ULPs. Builds with the scalar kernel (SLINGSHOT_SIMD=OFF) have nothing to
+// compare.
+//
+// Exits with 1 if any check fails. The build runs this on the shipped levels.
+
+#include "game/level_loader.hpp"
+#include "physics/gravity_kernel.hpp"
+#include "physics/quadtree.hpp"
+#include "physics/world.hpp"
+#include "entities/asteroid.hpp"
+#include "entities/sun.hpp"
+#include "config/display.hpp"
+#include "config/physics.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    using namespace slingshot;
+
+    // Worst |a_tree - a_direct| allowed at the default theta, relative to the
+    // world's RMS direct acceleration. Relative to the local |a_direct| the
+    // error is unbounded wherever opposing pulls cancel.
+    constexpr double BARNES_HUT_MAX_ERROR = 0.1;
+
+    // Worst |a_vector - a_scalar| per component, in ULPs of the sum of the
+    // terms' magnitudes (the scale of the rounding either summation order picks
+    // up, which stays meaningful where the terms cancel) per square root of the
+    // source count, as rounding errors add up like a random walk. Measured
+    // worst is 1.8 (AVX2, a handful of sources) and under 0.7 from a few
+    // hundred sources up; a wrong softening radius is off by 70 or more.
+    constexpr double KERNEL_ULPS_PER_ROOT_SOURCE = 4.0;
+
+    // Probe spacing across the screen, in world units
+    constexpr float PROBE_SPACING = 25.0f;
+
+    // Random worlds for the kernel check: every size up to this, then a few large ones
+    constexpr size_t RANDOM_SMALL_WORLDS = 40;
+    constexpr size_t RANDOM_LARGE_WORLDS[] = {257, 1000, 3001};
+
+    // Same as the kernel's: directions shorter than this contribute nothing
+    constexpr float MIN_DIRECTION = 1e-8f;
+
+    struct Probe
+    {
+        Vec2 pos;
+        float radius;
+        int self; // Body index at this position, -1 for empty space
+    };
+
+    struct ErrorStats
+    {
+        size_t samples = 0;
+        double worstError = 0.0;
+        double sumSquaredAccel = 0.0;
+        double sumRelative = 0.0; // Local relative error, reported only
+
+        void add(Vec2 approx, Vec2 exact)
+        {
+            double magnitude = exact.magnitude();
+            if (magnitude == 0.0)
+                return;
+            double error = (approx - exact).magnitude();
+            worstError = std::max(worstError, error);
+            sumSquaredAccel += magnitude * magnitude;
+            sumRelative += error / magnitude;
+            samples++;
+        }
+
+        double worst() const { return samples ? worstError / std::sqrt(sumSquaredAccel / samples) : 0.0; }
+        double meanRelative() const { return samples ? sumRelative / samples : 0.0; }
+    };
+
+    struct UlpStats
+    {
+        size_t samples = 0;
+        size_t exact = 0; // Bit-identical to the scalar sum
+        double worst = 0.0; // ULPs per square root of the source count
+
+        void add(float vector, float scalar, double scale, size_t sources)
+        {
+            samples++;
+            if (std::memcmp(&vector, &scalar, sizeof(float)) == 0)
+            {
+                exact++;
+                return;
+            }
+            // ulp of the scale as a float; a zero scale means both sums must be zero
+            int exponent;
+            std::frexp(scale, &exponent);
+            double ulp = scale > 0.0 ? std::ldexp(1.0, exponent - 24) : 0.0;
+            double ulps = ulp > 0.0 ? std::abs(double(vector) - double(scalar)) / ulp : HUGE_VAL;
+            worst = std::max(worst, ulps / std::sqrt(static_cast<double>(sources)));
+        }
+
+        void merge(const UlpStats &other)
+        {
+            samples += other.samples;
+            exact += other.exact;
+            worst = std::max(worst, other.worst);
+        }
+    };
+
+    // Same world as the bench's synthetic one: a sun among loose asteroids
+    void buildSyntheticWorld(PhysicsWorld &world, int bodyCount)
+    {
+        std::mt19937 rng(1234);
+        std::uniform_real_distribution<float> x(0.0f, display::WORLD_WIDTH);
+        std::uniform_real_distribution<float> y(0.0f, display::WORLD_HEIGHT);
+
+        world.addEntity(std::make_unique<Sun>(Vec2(display::WORLD_WIDTH / 2, display::WORLD_HEIGHT / 2)));
+        for (int i = 1; i < bodyCount; i++)
+        {
+            world.addEntity(std::make_unique<Asteroid>(Vec2(x(rng), y(rng)), false));
+        }
+    }
+
+    // Every body affected by gravity, then a grid of agent-sized probes
+    std::vector<Probe> worldProbes(const BodyStore &bodies)
+    {
+        std::vector<Probe> probes;
+        for (size_t i = 0; i < bodies.size(); i++)
+        {
+            if (bodies.flags()[i] & body_flags::AFFECTED_BY_GRAVITY)
+                probes.push_back({bodies.getPos(i), bodies.radius()[i], static_cast<int>(i)});
+        }
+        for (float y = PROBE_SPACING / 2; y < display::WORLD_HEIGHT; y += PROBE_SPACING)
+        {
+            for (float x = PROBE_SPACING / 2; x < display::WORLD_WIDTH; x += PROBE_SPACING)
+            {
+                probes.push_back({Vec2(x, y), physics::defaults::AGENT_RADIUS, -1});
+            }
+        }
+        return probes;
+    }
+
+    ErrorStats measureBarnesHut(const GravitySources &sources, const std::vector<Probe> &probes)
+    {
+        // Built as PhysicsWorld::buildQuadTree() does
+        std::vector<QuadTree::Source> treeSources;
+        for (size_t i = 0; i < sources.size(); i++)
+        {
+            treeSources.push_back({Vec2(sources.x[i], sources.y[i]), sources.mass[i], sources.radius[i], sources.index[i]});
+        }
+        QuadTree tree;
+        tree.build(treeSources);
+
+        ErrorStats stats;
+        for (const Probe &probe : probes)
+        {
+            stats.add(tree.accelerationAt(probe.pos, probe.radius, probe.self, physics::BARNES_HUT_THETA),
+                      gravity::accelerationAtScalar(sources, probe.pos, probe.radius));
+        }
+        return stats;
+    }
+
+    UlpStats measureKernel(const GravitySources &sources, const std::vector<Probe> &probes)
+    {
+        UlpStats stats;
+        for (const Probe &probe : probes)
+        {
+            // Sum of the terms' magnitudes per component, in double
+            double scaleX = 0.0;
+            double scaleY = 0.0;
+            for (size_t i = 0; i < sources.size(); i++)
+            {
+                double dx = double(sources.x[i]) - probe.pos.x;
+                double dy = double(sources.y[i]) - probe.pos.y;
+                double dist = std::sqrt(dx * dx + dy * dy);
+                if (dist < MIN_DIRECTION)
+                    continue;
+                double minDist = double(sources.radius[i]) + probe.radius;
+                double accel = double(physics::G) * sources.mass[i] / std::max(dist * dist, minDist * minDist);
+                scaleX += std::abs(dx) / dist * accel;
+                scaleY += std::abs(dy) / dist * accel;
+            }
+
+            Vec2 vector = gravity::accelerationAt(sources, probe.pos, probe.radius);
+            Vec2 scalar = gravity::accelerationAtScalar(sources, probe.pos, probe.radius);
+            stats.add(vector.x, scalar.x, scaleX, sources.size());
+            stats.add(vector.y, scalar.y, scaleY, sources.size());
+        }
+        return stats;
+    }
+
+    // Sources spread over the screen with the shipped bodies' range of masses
+    // and radii, probed at random points and around each source: at its
+    // centre, just below the direction cut-off, inside the softened core, and
+    // on either side of and exactly at the softening radius
+    UlpStats measureRandomWorld(size_t count, std::mt19937 &rng)
+    {
+        std::uniform_real_distribution<float> x(0.0f, display::WORLD_WIDTH);
+        std::uniform_real_distribution<float> y(0.0f, display::WORLD_HEIGHT);
+        std::uniform_real_distribution<float> mass(physics::defaults::ASTEROID_MASS, physics::defaults::SINGULARITY_MASS);
+        std::uniform_real_distribution<float> radius(physics::defaults::ASTEROID_RADIUS, physics::defaults::SUN_RADIUS);
+        std::uniform_real_distribution<float> angle(0.0f, 6.2831853f);
+
+        GravitySources sources;
+        for (size_t i = 0; i < count; i++)
+        {
+            sources.x.push_back(x(rng));
+            sources.y.push_back(y(rng));
+            sources.mass.push_back(mass(rng));
+            sources.radius.push_back(radius(rng));
+            sources.index.push_back(static_cast<int>(i));
+        }
+
+        const float probeRadius = physics::defaults::AGENT_RADIUS;
+        const float distances[] = {0.5f, 1.0f - 1e-6f, 1.0f, 1.0f + 1e-6f, 2.0f};
+
+        std::vector<Probe> probes;
+        for (int i = 0; i < 64; i++)
+            probes.push_back({Vec2(x(rng), y(rng)), probeRadius, -1});
+
+        // Around at most 64 sources, so large worlds stay quick
+        size_t step = std::max<size_t>(1, count / 64);
+        for (size_t i = 0; i < count; i += step)
+        {
+            Vec2 center(sources.x[i], sources.y[i]);
+            Vec2 direction = Vec2(1.0f, 0.0f).rotated(angle(rng));
+            float minDist = sources.radius[i] + probeRadius;
+
+            probes.push_back({center, probeRadius, -1});
+            probes.push_back({center + direction * (MIN_DIRECTION * 0.5f), probeRadius, -1});
+            for (float distance : distances)
+                probes.push_back({center + direction * (minDist * distance), probeRadius, -1});
+        }
+        return measureKernel(sources, probes);
+    }
+
+    bool reportBarnesHut(const std::string &name, const ErrorStats &stats)
+    {
+        bool ok = stats.worst() <= BARNES_HUT_MAX_ERROR;
+        std::printf("barnes-hut %s: %s (%zu samples, worst %.3g of RMS, mean local %.3g, bound %.3g)\n", name.c_str(),
+                    ok ? "ok" : "FAIL", stats.samples, stats.worst(), stats.meanRelative(), BARNES_HUT_MAX_ERROR);
+        return ok;
+    }
+
+    bool reportKernel(const std::string &name, const UlpStats &stats)
+    {
+        bool ok = stats.worst <= KERNEL_ULPS_PER_ROOT_SOURCE;
+        std::printf("%s kernel %s: %s (%zu components, %zu bit-identical, worst %.3g ulps/sqrt(n), bound %.3g)\n",
+                    gravity::kernelName(), name.c_str(), ok ? "ok" : "FAIL", stats.samples, stats.exact, stats.worst,
+                    KERNEL_ULPS_PER_ROOT_SOURCE);
+        return ok;
+    }
+
+    bool checkWorld(const std::string &name, const PhysicsWorld &world, bool vectorKernel)
+    {
+        GravitySources sources;
+        sources.gather(world.getBodies());
+        std::vector<Probe> probes = worldProbes(world.getBodies());
+
+        bool ok = reportBarnesHut(name, measureBarnesHut(sources, probes));
+        if (vectorKernel)
+            ok = reportKernel(name, measureKernel(sources, probes)) && ok;
+        return ok;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    std::vector<std::string> inputs(argv + 1, argv + argc);
+    if (inputs.empty())
+    {
+        std::cerr << "Usage: slingshot_check_gravity LEVEL.json..." << std::endl;
+        return 1;
+    }
+
+    bool vectorKernel = std::strcmp(gravity::kernelName(), "scalar") != 0;
+    if (!vectorKernel)
+        std::printf("scalar kernel: no vector kernel to check\n");
+
+    int failures = 0;
+    for (const auto &input : inputs)
+    {
+        PhysicsWorld world;
+        LevelData data;
+        if (!LevelLoader::load(input, world, data))
+        {
+            std::cerr << input << ": cannot read level" << std::endl;
+            failures++;
+            continue;
+        }
+        if (!checkWorld(input, world, vectorKernel))
+            failures++;
+    }
+
+    PhysicsWorld synthetic;
+    buildSyntheticWorld(synthetic, physics::BARNES_HUT_THRESHOLD);
+    if (!checkWorld("synthetic/" + std::to_string(physics::BARNES_HUT_THRESHOLD), synthetic, vectorKernel))
+        failures++;
+
+    if (vectorKernel)
+    {
+        std::mt19937 rng(1234);
+        UlpStats small;
+        for (size_t count = 1; count <= RANDOM_SMALL_WORLDS; count++)
+            small.merge(measureRandomWorld(count, rng));
+        if (!reportKernel("random/1-" + std::to_string(RANDOM_SMALL_WORLDS), small))
+            failures++;
+
+        for (size_t count : RANDOM_LARGE_WORLDS)
+        {
+            if (!reportKernel("random/" + std::to_string(count), measureRandomWorld(count, rng)))
+                failures++;
+        }
+    }
+
+    return failures == 0 ? 0 : 1;
+}
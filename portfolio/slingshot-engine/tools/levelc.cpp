@@ -0,0 +1,225 @@
+// Level compiler: converts JSON levels into the binary format the engine
+// loads at runtime (see game/level_binary.hpp).
+//
+// Usage: slingshot_levelc [--out=DIR | --pack=FILE] [--check] LEVEL.json...
+//
+// Each LEVEL.json becomes DIR/LEVEL.lvl (DIR defaults to the input's own
+// directory), or with --pack all of them go into one level pack instead.
+// --check reads every written file back and verifies that it decodes to the
+// same level as the JSON and builds an identical world.
+
+#include "game/level_loader.hpp"
+#include "game/level_binary.hpp"
+#include "game/level_pack.hpp"
+#include "physics/world.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    using namespace slingshot;
+
+    struct Options
+    {
+        std::string outDir;
+        std::string packPath;
+        bool check = false;
+        std::vector<std::string> inputs;
+    };
+
+    std::string outputPath(const Options &options, const std::string &input)
+    {
+        size_t slash = input.find_last_of('/');
+        std::string dir = slash == std::string::npos ? "." : input.substr(0, slash);
+        std::string file = slash == std::string::npos ? input : input.substr(slash + 1);
+
+        size_t dot = file.find_last_of('.');
+        if (dot != std::string::npos)
+            file.erase(dot);
+
+        return (options.outDir.empty() ? dir : options.outDir) + "/" + file + level_binary::FILE_EXTENSION;
+    }
+
+    bool writeFile(const std::string &path, const std::vector<uint8_t> &bytes)
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char *>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        return static_cast<bool>(file);
+    }
+
+    bool same(Vec2 a, Vec2 b)
+    {
+        return a.x == b.x && a.y == b.y;
+    }
+
+    bool sameWorld(const PhysicsWorld &a, const PhysicsWorld &b)
+    {
+        const BodyStore &x = a.getBodies();
+        const BodyStore &y = b.getBodies();
+        if (x.size() != y.size())
+            return false;
+
+        for (size_t i = 0; i < x.size(); i++)
+        {
+            if (!same(x.getPos(i), y.getPos(i)) || !same(x.getVel(i), y.getVel(i)) ||
+                x.mass()[i] != y.mass()[i] || x.radius()[i] != y.radius()[i] ||
+                x.flags()[i] != y.flags()[i])
+                return false;
+        }
+        return true;
+    }
+
+    // Reads the compiled file back and compares it with the JSON source
+    bool check(const std::string &input, const std::string &output, const LevelDefinition &source)
+    {
+        std::vector<uint8_t> bytes;
+        LevelDefinition decoded;
+        if (!level_binary::readFile(output, bytes) || !level_binary::decode(bytes.data(), bytes.size(), decoded))
+        {
+            std::cerr << output << ": does not decode" << std::endl;
+            return false;
+        }
+        if (decoded != source)
+        {
+            std::cerr << output << ": decodes to a different level than " << input << std::endl;
+            return false;
+        }
+
+        PhysicsWorld fromJson;
+        PhysicsWorld fromBinary;
+        LevelData jsonData;
+        LevelData binaryData;
+        if (!LevelLoader::load(input, fromJson, jsonData) ||
+            !level_binary::load(output, fromBinary, binaryData) ||
+            !sameWorld(fromJson, fromBinary))
+        {
+            std::cerr << output << ": builds a different world than " << input << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    bool compile(const Options &options, const std::string &input, const LevelDefinition &level)
+    {
+        std::vector<uint8_t> bytes;
+        level_binary::encode(level, bytes);
+
+        std::string output = outputPath(options, input);
+        if (!writeFile(output, bytes))
+        {
+            std::cerr << output << ": cannot write" << std::endl;
+            return false;
+        }
+
+        if (options.check && !check(input, output, level))
+            return false;
+
+        std::printf("%s -> %s (%zu entities, %zu bytes)\n", input.c_str(), output.c_str(),
+                    level.entities.size(), bytes.size());
+        return true;
+    }
+
+    bool writePack(const Options &options, const std::vector<LevelDefinition> &levels)
+    {
+        std::vector<uint8_t> bytes;
+        LevelPack::encode(levels, bytes);
+        if (!writeFile(options.packPath, bytes))
+        {
+            std::cerr << options.packPath << ": cannot write" << std::endl;
+            return false;
+        }
+
+        if (options.check)
+        {
+            LevelPack pack;
+            if (!pack.open(options.packPath) || pack.getLevelCount() != levels.size())
+            {
+                std::cerr << options.packPath << ": does not open" << std::endl;
+                return false;
+            }
+            for (size_t i = 0; i < levels.size(); i++)
+            {
+                const LevelDefinition *decoded = pack.find(levels[i].info.id);
+                if (!decoded || *decoded != levels[i])
+                {
+                    std::cerr << options.packPath << ": level " << levels[i].info.id
+                              << " differs from " << options.inputs[i] << std::endl;
+                    return false;
+                }
+            }
+        }
+
+        std::printf("%zu levels -> %s (%zu bytes)\n", levels.size(), options.packPath.c_str(), bytes.size());
+        return true;
+    }
+
+    bool parseArgs(int argc, char **argv, Options &options)
+    {
+        for (int i = 1; i < argc; i++)
+        {
+            std::string arg = argv[i];
+            if (arg.compare(0, 6, "--out=") == 0)
+                options.outDir = arg.substr(6);
+            else if (arg.compare(0, 7, "--pack=") == 0)
+                options.packPath = arg.substr(7);
+            else if (arg == "--check")
+                options.check = true;
+            else if (arg.compare(0, 2, "--") != 0)
+                options.inputs.push_back(arg);
+            else
+            {
+                std::cerr << "Unknown argument: " << arg << std::endl;
+                options.inputs.clear();
+                break;
+            }
+        }
+
+        if (options.inputs.empty())
+        {
+            std::cerr << "Usage: slingshot_levelc [--out=DIR | --pack=FILE] [--check] LEVEL.json..." << std::endl;
+            return false;
+        }
+        return true;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    Options options;
+    if (!parseArgs(argc, argv, options))
+        return 1;
+
+    std::vector<LevelDefinition> levels(options.inputs.size());
+    for (size_t i = 0; i < options.inputs.size(); i++)
+    {
+        if (!LevelLoader::read(options.inputs[i], levels[i]))
+        {
+            std::cerr << options.inputs[i] << ": cannot read level" << std::endl;
+            return 1;
+        }
+        for (size_t j = 0; j < i; j++)
+        {
+            if (levels[j].info.id == levels[i].info.id)
+            {
+                std::cerr << options.inputs[i] << ": level id " << levels[i].info.id
+                          << " already used by " << options.inputs[j] << std::endl;
+                return 1;
+            }
+        }
+    }
+
+    if (!options.packPath.empty())
+        return writePack(options, levels) ? 0 : 1;
+
+    int failures = 0;
+    for (size_t i = 0; i < levels.size(); i++)
+    {
+        if (!compile(options, options.inputs[i], levels[i]))
+            failures++;
+    }
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,462 @@
+// Batch level solver: sweeps the slingshot's launch space for every level,
+// flying each candidate with the real PhysicsWorld step and win/lose checks.
+//
+// Usage: slingshot_solve [--angles=N] [--powers=N] [--max-seconds=S] [--threads=N]
+//                        [--levels=DIR | --pack=FILE] [--json=FILE] [LEVEL_ID...]
+//
+// Angles are in degrees, counter-clockwise from +x as seen on screen; power
+// is the pull distance as a fraction of the slingshot's maximum radius. The
+// agent is launched as soon as the level loads, before orbiters have moved.
+// Exits with 1 if any level has no winning launch, or if no levels load or a
+// requested LEVEL_ID does not exist.
+
+#include "physics/world.hpp"
+#include "game/level_loader.hpp"
+#include "game/level_pack.hpp"
+#include "game/slingshot.hpp"
+#include "entities/agent.hpp"
+#include "core/thread_pool.hpp"
+#include "config/physics.hpp"
+#include "lib/json.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#ifndef SLINGSHOT_LEVELS_DIR
+#define SLINGSHOT_LEVELS_DIR "levels"
+#endif
+
+namespace
+{
+    using namespace slingshot;
+    using Clock = std::chrono::steady_clock;
+
+    // The table lists the largest regions; --json has all of them
+    constexpr size_t PRINTED_REGIONS = 3;
+
+    struct Options
+    {
+        int angles = 180;
+        int powers = 25;
+        float maxSeconds = 30.0f;
+        int threads = ThreadPool::hardwareThreads();
+        std::string levelsDir = SLINGSHOT_LEVELS_DIR;
+        std::string packPath;
+        std::string jsonPath;
+        std::vector<int> levelIds;
+    };
+
+    // How one candidate launch ended; Timeout means still flying at maxSeconds
+    enum class Flight : uint8_t
+    {
+        Skipped,
+        Won,
+        HitGravityWell,
+        OutOfBounds,
+        Timeout
+    };
+
+    struct Candidate
+    {
+        int angle = 0; // Grid indices
+        int power = 0;
+        float angleDegrees = 0.0f;
+        float powerFraction = 0.0f;
+        float speed = 0.0f;
+        int steps = 0;
+    };
+
+    struct Region
+    {
+        float angleFrom = 0.0f; // Counter-clockwise arc, may wrap past 360
+        float angleTo = 0.0f;
+        float powerFrom = 0.0f;
+        float powerTo = 0.0f;
+        int cells = 0;
+    };
+
+    struct LevelReport
+    {
+        int id = 0;
+        std::string name;
+        int candidates = 0;
+        int counts[5] = {};
+        std::vector<Region> regions; // Largest first
+        bool solved = false;
+        Candidate minPower;
+        Candidate fastest;
+        double seconds = 0.0;
+    };
+
+    struct Grid
+    {
+        int angles;
+        int powers;
+        std::vector<Flight> flights; // angle-major
+        std::vector<int> steps;
+
+        Flight at(int angle, int power) const { return flights[static_cast<size_t>(angle * powers + power)]; }
+    };
+
+    Candidate candidateAt(const Options &options, int angle, int power)
+    {
+        Candidate c;
+        c.angle = angle;
+        c.power = power;
+        c.angleDegrees = 360.0f * angle / options.angles;
+        c.powerFraction = static_cast<float>(power + 1) / options.powers;
+        return c;
+    }
+
+    Flight fly(PhysicsWorld &world, const LevelDefinition &level, Vec2 velocity, int maxSteps, int &steps)
+    {
+        world.clear();
+        level.build(world);
+        world.addEntity(std::make_unique<Agent>(level.info.spawn));
+        world.getAgent()->setVel(velocity);
+
+        for (steps = 1; steps <= maxSteps; steps++)
+        {
+            world.update(physics::TIME_STEP);
+            switch (world.checkAgent())
+            {
+            case AgentOutcome::ReachedGoal:
+                return Flight::Won;
+            case AgentOutcome::HitGravityWell:
+                return Flight::HitGravityWell;
+            case AgentOutcome::OutOfBounds:
+                return Flight::OutOfBounds;
+            case AgentOutcome::None:
+                break;
+            }
+        }
+        steps = maxSteps;
+        return Flight::Timeout;
+    }
+
+    // Connected winning cells (4-neighbour, wrapping in angle) as angle/power ranges
+    std::vector<Region> findRegions(const Options &options, const Grid &grid)
+    {
+        std::vector<Region> regions;
+        std::vector<char> seen(grid.flights.size(), 0);
+        std::vector<std::pair<int, int>> stack;
+
+        for (int a = 0; a < grid.angles; a++)
+        {
+            for (int p = 0; p < grid.powers; p++)
+            {
+                size_t start = static_cast<size_t>(a * grid.powers + p);
+                if (seen[start] || grid.flights[start] != Flight::Won)
+                    continue;
+
+                std::vector<char> angleUsed(grid.angles, 0);
+                int minPower = p;
+                int maxPower = p;
+                int cells = 0;
+
+                seen[start] = 1;
+                stack.push_back({a, p});
+                while (!stack.empty())
+                {
+                    auto cell = stack.back();
+                    stack.pop_back();
+                    cells++;
+                    angleUsed[cell.first] = 1;
+                    minPower = std::min(minPower, cell.second);
+                    maxPower = std::max(maxPower, cell.second);
+
+                    const std::pair<int, int> neighbours[] = {
+                        {(cell.first + 1) % grid.angles, cell.second},
+                        {(cell.first + grid.angles - 1) % grid.angles, cell.second},
+                        {cell.first, cell.second + 1},
+                        {cell.first, cell.second - 1}};
+                    for (const auto &n : neighbours)
+                    {
+                        if (n.second < 0 || n.second >= grid.powers)
+                            continue;
+                        size_t index = static_cast<size_t>(n.first * grid.powers + n.second);
+                        if (!seen[index] && grid.flights[index] == Flight::Won)
+                        {
+                            seen[index] = 1;
+                            stack.push_back(n);
+                        }
+                    }
+                }
+
+                // The arc is the circle minus the longest run of unused angles
+                int gapStart = 0;
+                int gapLength = 0;
+                for (int i = 0; i < grid.angles; i++)
+                {
+                    int length = 0;
+                    while (length < grid.angles && !angleUsed[(i + length) % grid.angles])
+                        length++;
+                    if (length > gapLength)
+                    {
+                        gapLength = length;
+                        gapStart = i;
+                    }
+                }
+
+                int first = (gapStart + gapLength) % grid.angles;
+                int last = first + (grid.angles - gapLength) - 1;
+
+                Region region;
+                region.angleFrom = candidateAt(options, first, 0).angleDegrees;
+                region.angleTo = 360.0f * last / grid.angles;
+                region.powerFrom = candidateAt(options, 0, minPower).powerFraction;
+                region.powerTo = candidateAt(options, 0, maxPower).powerFraction;
+                region.cells = cells;
+                regions.push_back(region);
+            }
+        }
+
+        std::sort(regions.begin(), regions.end(), [](const Region &a, const Region &b)
+                  { return a.cells > b.cells; });
+        return regions;
+    }
+
+    LevelReport solve(const Options &options, const LevelDefinition &level, ThreadPool &pool)
+    {
+        auto start = Clock::now();
+
+        Grid grid{options.angles, options.powers, {}, {}};
+        size_t count = static_cast<size_t>(options.angles * options.powers);
+        grid.flights.assign(count, Flight::Skipped);
+        grid.steps.assign(count, 0);
+        int maxSteps = static_cast<int>(std::ceil(options.maxSeconds / physics::TIME_STEP));
+
+        Slingshot slingshot; // Candidates the game would drop are skipped
+        slingshot.setAnchor(level.info.spawn);
+
+        // A few candidates per task: flights vary a lot in length
+        pool.parallelFor(count, 4, [&](size_t begin, size_t end)
+                         {
+            PhysicsWorld world;
+            for (size_t i = begin; i < end; i++)
+            {
+                Candidate c = candidateAt(options, static_cast<int>(i) / options.powers, static_cast<int>(i) % options.powers);
+                Vec2 velocity = slingshot.pullVelocity(c.angleDegrees, c.powerFraction);
+                if (!slingshot.canLaunch(velocity))
+                    continue;
+                grid.flights[i] = fly(world, level, velocity, maxSteps, grid.steps[i]);
+            } });
+
+        LevelReport report;
+        report.id = level.info.id;
+        report.name = level.info.name;
+
+        for (size_t i = 0; i < count; i++)
+        {
+            Flight flight = grid.flights[i];
+            report.counts[static_cast<int>(flight)]++;
+            if (flight == Flight::Skipped)
+                continue;
+            report.candidates++;
+            if (flight != Flight::Won)
+                continue;
+
+            Candidate c = candidateAt(options, static_cast<int>(i) / options.powers, static_cast<int>(i) % options.powers);
+            c.speed = slingshot.pullVelocity(c.angleDegrees, c.powerFraction).magnitude();
+            c.steps = grid.steps[i];
+
+            if (!report.solved || c.speed < report.minPower.speed ||
+                (c.speed == report.minPower.speed && c.steps < report.minPower.steps))
+                report.minPower = c;
+            if (!report.solved || c.steps < report.fastest.steps ||
+                (c.steps == report.fastest.steps && c.speed < report.fastest.speed))
+                report.fastest = c;
+            report.solved = true;
+        }
+
+        report.regions = findRegions(options, grid);
+        report.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        return report;
+    }
+
+    bool loadLevels(const Options &options, std::vector<LevelDefinition> &levels)
+    {
+        if (options.packPath.empty())
+        {
+            LevelLoader::readAll(options.levelsDir, levels);
+            return true;
+        }
+
+        LevelPack pack;
+        if (!pack.open(options.packPath) || !pack.readAll(levels))
+        {
+            std::cerr << options.packPath << ": cannot read level pack" << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    const char *flightName(int flight)
+    {
+        const char *names[] = {"skipped", "won", "hit_gravity_well", "out_of_bounds", "timeout"};
+        return names[flight];
+    }
+
+    nlohmann::json toJson(const Options &options, const std::vector<LevelReport> &reports)
+    {
+        auto candidateJson = [](const Candidate &c)
+        {
+            return nlohmann::json{{"angle", c.angleDegrees}, {"power", c.powerFraction}, {"speed", c.speed}, {"steps", c.steps}};
+        };
+
+        nlohmann::json levels = nlohmann::json::array();
+        for (const auto &r : reports)
+        {
+            nlohmann::json outcomes;
+            for (int f = 1; f < 5; f++)
+                outcomes[flightName(f)] = r.counts[f];
+
+            nlohmann::json regions = nlohmann::json::array();
+            for (const auto &region : r.regions)
+            {
+                regions.push_back({{"angle_from", region.angleFrom}, {"angle_to", region.angleTo},
+                                   {"power_from", region.powerFrom}, {"power_to", region.powerTo},
+                                   {"cells", region.cells}});
+            }
+
+            nlohmann::json level = {
+                {"id", r.id},
+                {"name", r.name},
+                {"solved", r.solved},
+                {"candidates", r.candidates},
+                {"outcomes", outcomes},
+                {"regions", regions},
+                {"solve_seconds", r.seconds}};
+            if (r.solved)
+            {
+                level["min_power"] = candidateJson(r.minPower);
+                level["fastest"] = candidateJson(r.fastest);
+            }
+            levels.push_back(level);
+        }
+
+        return {
+            {"context", {{"executable", "slingshot_solve"},
+                         {"angles", options.angles},
+                         {"powers", options.powers},
+                         {"max_seconds", options.maxSeconds},
+                         {"threads", options.threads}}},
+            {"levels", levels}};
+    }
+
+    bool parseArgs(int argc, char **argv, Options &options)
+    {
+        for (int i = 1; i < argc; i++)
+        {
+            std::string arg = argv[i];
+            auto value = [&arg](const char *prefix) -> const char *
+            {
+                size_t len = std::char_traits<char>::length(prefix);
+                return arg.compare(0, len, prefix) == 0 ? arg.c_str() + len : nullptr;
+            };
+
+            if (const char *v = value("--angles="))
+                options.angles = std::max(1, std::atoi(v));
+            else if (const char *v = value("--powers="))
+                options.powers = std::max(1, std::atoi(v));
+            else if (const char *v = value("--max-seconds="))
+                options.maxSeconds = static_cast<float>(std::atof(v));
+            else if (const char *v = value("--threads="))
+                options.threads = std::max(1, std::atoi(v));
+            else if (const char *v = value("--levels="))
+                options.levelsDir = v;
+            else if (const char *v = value("--pack="))
+                options.packPath = v;
+            else if (const char *v = value("--json="))
+                options.jsonPath = v;
+            else if (!arg.empty() && arg[0] != '-')
+                options.levelIds.push_back(std::atoi(arg.c_str()));
+            else
+            {
+                std::cerr << "Unknown argument: " << arg << std::endl;
+                std::cerr << "Usage: slingshot_solve [--angles=N] [--powers=N] [--max-seconds=S] [--threads=N] "
+                             "[--levels=DIR | --pack=FILE] [--json=FILE] [LEVEL_ID...]"
+                          << std::endl;
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    Options options;
+    if (!parseArgs(argc, argv, options))
+        return 1;
+
+    std::vector<LevelDefinition> levels;
+    if (!loadLevels(options, levels))
+        return 1;
+    if (levels.empty())
+    {
+        std::cerr << "No levels found" << std::endl;
+        return 1;
+    }
+    for (int id : options.levelIds)
+    {
+        if (std::none_of(levels.begin(), levels.end(), [id](const LevelDefinition &level)
+                         { return level.info.id == id; }))
+        {
+            std::cerr << "Level " << id << " not found" << std::endl;
+            return 1;
+        }
+    }
+
+    ThreadPool pool(options.threads);
+    std::vector<LevelReport> reports;
+
+    std::printf("%d angles x %d powers, %.0f s flights, %d threads\n\n",
+                options.angles, options.powers, options.maxSeconds, pool.getThreadCount());
+    std::printf("%-6s %-22s %6s %7s %8s %15s %15s %9s\n",
+                "Level", "Name", "Wins", "Win %", "Regions", "Min power", "Fastest", "Time (s)");
+
+    for (const auto &level : levels)
+    {
+        if (!options.levelIds.empty() &&
+            std::find(options.levelIds.begin(), options.levelIds.end(), level.info.id) == options.levelIds.end())
+            continue;
+
+        LevelReport r = solve(options, level, pool);
+        char minPower[32] = "-";
+        char fastest[32] = "-";
+        if (r.solved)
+        {
+            std::snprintf(minPower, sizeof(minPower), "%.0f deg %3.0f%%", r.minPower.angleDegrees, r.minPower.powerFraction * 100.0f);
+            std::snprintf(fastest, sizeof(fastest), "%.2f s", r.fastest.steps * physics::TIME_STEP);
+        }
+        std::printf("%-6d %-22.22s %6d %6.1f%% %8zu %15s %15s %9.2f\n",
+                    r.id, r.name.c_str(), r.counts[static_cast<int>(Flight::Won)],
+                    r.candidates > 0 ? 100.0 * r.counts[static_cast<int>(Flight::Won)] / r.candidates : 0.0,
+                    r.regions.size(), minPower, fastest, r.seconds);
+        for (size_t i = 0; i < r.regions.size() && i < PRINTED_REGIONS; i++)
+        {
+            const Region &region = r.regions[i];
+            std::printf("%6s   region: %.0f-%.0f deg, %.0f-%.0f%% power (%d launches)\n", "",
+                        region.angleFrom, region.angleTo, region.powerFrom * 100.0f, region.powerTo * 100.0f, region.cells);
+        }
+        reports.push_back(r);
+    }
+
+    if (!options.jsonPath.empty())
+    {
+        std::ofstream out(options.jsonPath);
+        out << toJson(options, reports).dump(2) << std::endl;
+        std::cout << "\nResults written to " << options.jsonPath << std::endl;
+    }
+
+    bool allSolved = std::all_of(reports.begin(), reports.end(), [](const LevelReport &r)
+                                 { return r.solved; });
+    return allSolved ? 0 : 1;
+}
@@ -0,0 +1,686 @@
+// Replay verifier: re-simulates submitted runs with the core engine and prints
+// one verdict per submission as a line of JSON.
+//
+// Usage: slingshot_verify [--threads=N] [--levels=DIR | --pack=FILE] [--golden=FILE] [--queue=DIR] [FILE...]
+//        slingshot_verify --generate=N [--seed=S] [--levels=DIR | --pack=FILE]
+//        slingshot_verify --self-check | --update-golden [--golden=FILE] [--levels=DIR | --pack=FILE]
+//
+// Submissions come from stdin, one per line, unless a queue directory or files
+// are given, which hold one submission each. A submission is either the hex
+// replay from the game's getReplay(), or a JSON object
+//
+//   {"id": <echoed back>, "attempts": <claimed count>, "replay": "<hex>"}
+//
+// Queued files may also hold the raw binary replay. A submission is accepted
+// when every launch is one the slingshot can produce, its replay re-simulates
+// exactly, reaches the goal, and took the claimed number of attempts (when one
+// is given).
+//
+// --generate writes N submissions in the stdin format, honest and forged, for
+// testing locally: slingshot_verify --generate=1000 | slingshot_verify
+// Each carries an "expect" field; verifying checks verdicts against it and
+// exits with 1 on any mismatch.
+//
+// Verdicts are only meaningful if this build steps exactly like the game's.
+// Before verifying, every level is run through a fixed scenario and the world
+// hash compared with the checked-in golden hashes (tools/golden_hashes.txt);
+// on a mismatch nothing is verified and the exit status is 2. --self-check
+// runs just that, and deterministic builds run it after building this tool,
+// failing on a mismatch; --update-golden rewrites the file after a deliberate
+// physics or level change.
+
+#include "physics/world.hpp"
+#include "game/level_loader.hpp"
+#include "game/level_pack.hpp"
+#include "game/replay.hpp"
+#include "game/slingshot.hpp"
+#include "entities/agent.hpp"
+#include "core/thread_pool.hpp"
+#include "config/physics.hpp"
+#include "lib/json.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#ifndef SLINGSHOT_LEVELS_DIR
+#define SLINGSHOT_LEVELS_DIR "levels"
+#endif
+
+#ifndef SLINGSHOT_GOLDEN_HASHES
+#define SLINGSHOT_GOLDEN_HASHES "tools/golden_hashes.txt"
+#endif
+
+namespace
+{
+    using namespace slingshot;
+    using Clock = std::chrono::steady_clock;
+
+    // Replays per task; one ReplayPlayer is reused across each task's replays
+    constexpr size_t VERIFY_GRAIN = 16;
+
+    // Generated runs: flights give up (retry) after this many steps
+    constexpr uint32_t GENERATED_FLIGHT_STEPS = 600;
+
+    // Golden scenario: orbiters run for two seconds, then a fixed launch
+    // flies for up to ten. The velocity is a literal so no libm call is involved.
+    constexpr int GOLDEN_AIM_STEPS = 120;
+    constexpr int GOLDEN_FLIGHT_STEPS = 600;
+    const Vec2 GOLDEN_LAUNCH(420.0f, -300.0f);
+
+    struct Options
+    {
+        int threads = ThreadPool::hardwareThreads();
+        std::string levelsDir = SLINGSHOT_LEVELS_DIR;
+        std::string packPath;
+        std::string queueDir;
+        std::vector<std::string> files;
+        std::string goldenPath = SLINGSHOT_GOLDEN_HASHES;
+        int generate = 0;
+        unsigned seed = 1;
+        bool selfCheck = false;
+        bool updateGolden = false;
+    };
+
+    struct GoldenHash
+    {
+        int levelId = 0;
+        uint64_t ticks = 0;
+        uint64_t hash = 0;
+    };
+
+    struct Submission
+    {
+        nlohmann::json id;
+        std::vector<uint8_t> bytes;
+        int claimed = -1;   // -1 when no claim was made
+        int expect = -1;    // -1 unknown, else 0/1 (generated submissions)
+        std::string error;  // Set when the submission could not be read
+    };
+
+    struct Verdict
+    {
+        bool accepted = false;
+        int levelId = 0;
+        ReplayResult result;
+        std::string error;
+    };
+
+    bool loadLevels(const Options &options, std::vector<LevelDefinition> &levels)
+    {
+        if (options.packPath.empty())
+        {
+            LevelLoader::readAll(options.levelsDir, levels);
+            return true;
+        }
+
+        LevelPack pack;
+        if (!pack.open(options.packPath) || !pack.readAll(levels))
+        {
+            std::cerr << options.packPath << ": cannot read level pack" << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    // One line of stdin or one queued file
+    Submission parseSubmission(const std::string &text, nlohmann::json defaultId)
+    {
+        Submission submission;
+        submission.id = std::move(defaultId);
+
+        std::string hex = text;
+        if (!text.empty() && text[0] == '{')
+        {
+            auto json = nlohmann::json::parse(text, nullptr, false);
+            if (json.is_discarded() || !json.is_object() || !json.contains("replay") || !json["replay"].is_string())
+            {
+                submission.error = "not a submission object";
+                return submission;
+            }
+            if (json.contains("id"))
+                submission.id = json["id"];
+            if (json.contains("attempts") && json["attempts"].is_number_integer())
+                submission.claimed = json["attempts"].get<int>();
+            if (json.contains("expect") && json["expect"].is_boolean())
+                submission.expect = json["expect"].get<bool>() ? 1 : 0;
+            hex = json["replay"].get<std::string>();
+        }
+
+        if (!replay::fromHex(hex, submission.bytes))
+            submission.error = "replay is not hex";
+        return submission;
+    }
+
+    std::string trim(const std::string &text)
+    {
+        size_t begin = text.find_first_not_of(" \t\r\n");
+        size_t end = text.find_last_not_of(" \t\r\n");
+        return begin == std::string::npos ? std::string() : text.substr(begin, end - begin + 1);
+    }
+
+    bool readSubmissionFile(const std::string &path, nlohmann::json id, std::vector<Submission> &out)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+        {
+            std::cerr << path << ": cannot open" << std::endl;
+            return false;
+        }
+        std::string contents((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+        if (contents.compare(0, 4, "SRPL") == 0)
+        {
+            Submission submission;
+            submission.id = std::move(id);
+            submission.bytes.assign(contents.begin(), contents.end());
+            out.push_back(std::move(submission));
+        }
+        else
+        {
+            out.push_back(parseSubmission(trim(contents), std::move(id)));
+        }
+        return true;
+    }
+
+    bool readSubmissions(const Options &options, std::vector<Submission> &out)
+    {
+        if (!options.queueDir.empty())
+        {
+            std::error_code error;
+            std::vector<std::filesystem::path> paths;
+            for (const auto &entry : std::filesystem::directory_iterator(options.queueDir, error))
+            {
+                if (entry.is_regular_file())
+                    paths.push_back(entry.path());
+            }
+            if (error)
+            {
+                std::cerr << options.queueDir << ": " << error.message() << std::endl;
+                return false;
+            }
+
+            std::sort(paths.begin(), paths.end());
+            for (const auto &path : paths)
+            {
+                if (!readSubmissionFile(path.string(), path.filename().string(), out))
+                    return false;
+            }
+        }
+
+        for (const auto &path : options.files)
+        {
+            if (!readSubmissionFile(path, path, out))
+                return false;
+        }
+
+        if (options.queueDir.empty() && options.files.empty())
+        {
+            std::string line;
+            for (int number = 1; std::getline(std::cin, line); number++)
+            {
+                line = trim(line);
+                if (!line.empty())
+                    out.push_back(parseSubmission(line, number));
+            }
+        }
+        return true;
+    }
+
+    Verdict verify(const Submission &submission, const std::vector<LevelDefinition> &levels,
+                   const std::unordered_map<int, size_t> &levelIndex, ReplayPlayer &player)
+    {
+        Verdict verdict;
+        if (!submission.error.empty())
+        {
+            verdict.error = submission.error;
+            return verdict;
+        }
+
+        Replay replay;
+        if (!replay::decode(submission.bytes.data(), submission.bytes.size(), replay))
+        {
+            verdict.error = "malformed replay";
+            return verdict;
+        }
+        verdict.levelId = replay.levelId;
+
+        auto found = levelIndex.find(replay.levelId);
+        if (found == levelIndex.end())
+        {
+            verdict.error = "unknown level";
+            return verdict;
+        }
+
+        if (!player.play(levels[found->second], replay, verdict.result))
+            verdict.error = verdict.result.error;
+        else if (!verdict.result.won)
+            verdict.error = "no launch reached the goal";
+        else if (submission.claimed >= 0 && submission.claimed != verdict.result.attempts)
+            verdict.error = "claimed attempts differ";
+        else
+            verdict.accepted = true;
+        return verdict;
+    }
+
+    nlohmann::json toJson(const Submission &submission, const Verdict &verdict)
+    {
+        nlohmann::json json = {{"id", submission.id}, {"accepted", verdict.accepted}};
+        if (verdict.levelId != 0)
+            json["level"] = verdict.levelId;
+        if (verdict.result.valid)
+        {
+            json["won"] = verdict.result.won;
+            json["attempts"] = verdict.result.attempts;
+        }
+        if (submission.claimed >= 0)
+            json["claimed"] = submission.claimed;
+        if (!verdict.error.empty())
+            json["error"] = verdict.error;
+        if (!verdict.result.valid && !verdict.result.error.empty())
+            json["failed_launch"] = verdict.result.failedLaunch;
+        return json;
+    }
+
+    // Adds the agent and steps until the flight ends or the step budget runs out
+    AgentOutcome fly(PhysicsWorld &world, Vec2 spawn, Vec2 velocity)
+    {
+        world.addEntity(std::make_unique<Agent>(spawn));
+        world.getAgent()->setVel(velocity);
+
+        AgentOutcome outcome = AgentOutcome::None;
+        for (uint32_t i = 0; i < GENERATED_FLIGHT_STEPS && outcome == AgentOutcome::None; i++)
+        {
+            world.update(physics::TIME_STEP);
+            outcome = world.checkAgent();
+        }
+        return outcome;
+    }
+
+    // A run as a player would make it: a few misses at random moments, then
+    // (if the level has one) a known winning launch, all recorded live
+    Replay playRun(const LevelDefinition &level, const Vec2 *winning, std::mt19937 &rng)
+    {
+        PhysicsWorld world;
+        ReplayRecorder recorder;
+        WorldState start;
+        level.build(world);
+        world.saveState(start);
+        recorder.begin(level.info.id);
+
+        Slingshot slingshot;
+        slingshot.setAnchor(level.info.spawn);
+
+        int misses = static_cast<int>(rng() % 5);
+        for (int attempt = 0; attempt <= misses; attempt++)
+        {
+            recorder.recordEnd(world, AgentOutcome::None);
+            world.restoreState(start);
+
+            Vec2 velocity;
+            if (attempt == misses && winning)
+            {
+                velocity = *winning;
+            }
+            else
+            {
+                int wait = static_cast<int>(rng() % 120);
+                for (int i = 0; i < wait; i++)
+                    world.update(physics::TIME_STEP);
+                velocity = slingshot.pullVelocity(static_cast<float>(rng() % 360), 0.2f + 0.8f * (rng() % 100) / 100.0f);
+            }
+
+            recorder.recordLaunch(world, velocity);
+            AgentOutcome outcome = fly(world, level.info.spawn, velocity);
+            recorder.recordEnd(world, outcome);
+            if (outcome == AgentOutcome::ReachedGoal)
+                break;
+        }
+        return recorder.getReplay();
+    }
+
+    // First winning launch made as soon as the level loads, on a coarse sweep
+    bool findWinningLaunch(const LevelDefinition &level, Vec2 &velocity)
+    {
+        PhysicsWorld world;
+        Slingshot slingshot;
+        slingshot.setAnchor(level.info.spawn);
+        for (int power = 10; power >= 2; power--)
+        {
+            for (int angle = 0; angle < 360; angle += 5)
+            {
+                Vec2 candidate = slingshot.pullVelocity(static_cast<float>(angle), power / 10.0f);
+                world.clear();
+                level.build(world);
+                if (fly(world, level.info.spawn, candidate) == AgentOutcome::ReachedGoal)
+                {
+                    velocity = candidate;
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    // One launch straight from the level's start, recorded as it really flies
+    ReplayLaunch recordedLaunch(const LevelDefinition &level, Vec2 velocity)
+    {
+        PhysicsWorld world;
+        ReplayRecorder recorder;
+        level.build(world);
+        recorder.begin(level.info.id);
+        recorder.recordLaunch(world, velocity);
+        recorder.recordEnd(world, fly(world, level.info.spawn, velocity));
+        return recorder.getReplay().launches.front();
+    }
+
+    // Writes honest runs and forgeries whose verdict is known up front
+    void generate(const Options &options, const std::vector<LevelDefinition> &levels)
+    {
+        std::vector<Vec2> winning(levels.size());
+        std::vector<char> hasWinning(levels.size(), 0);
+        for (size_t i = 0; i < levels.size(); i++)
+            hasWinning[i] = findWinningLaunch(levels[i], winning[i]);
+
+        std::mt19937 rng(options.seed);
+        std::vector<uint8_t> bytes;
+        for (int n = 1; n <= options.generate; n++)
+        {
+            size_t level = rng() % levels.size();
+            Replay run = playRun(levels[level], hasWinning[level] ? &winning[level] : nullptr, rng);
+            bool won = !run.launches.empty() && run.launches.back().outcome == AgentOutcome::ReachedGoal;
+            int attempts = static_cast<int>(run.launches.size());
+
+            // Half honest; the rest forged in one of six ways
+            const char *kind = "honest";
+            bool expect = won;
+            unsigned forgery = rng() % 12;
+            switch (forgery)
+            {
+            case 6:
+                kind = "fewer_attempts";
+                attempts--;
+                expect = false;
+                break;
+            case 7:
+                kind = "flipped_outcome";
+                run.launches.front().outcome = run.launches.front().outcome == AgentOutcome::ReachedGoal
+                                                   ? AgentOutcome::OutOfBounds
+                                                   : AgentOutcome::ReachedGoal;
+                expect = false;
+                break;
+            case 8:
+                kind = "wrong_phase";
+                run.launches.back().phaseHash ^= 1;
+                expect = false;
+                break;
+            case 9:
+                kind = "truncated";
+                expect = false;
+                break;
+            case 10:
+            case 11:
+            {
+                // A first miss no drag can produce, flown for real so that
+                // only the speed check tells it apart from an honest run
+                Slingshot slingshot;
+                bool over = forgery == 10;
+                float angle = static_cast<float>(rng() % 360);
+                float fraction = static_cast<float>(rng() % 100) / 100.0f;
+                float speed = over ? slingshot.getMaxLaunchSpeed() * (1.25f + fraction)
+                                   : Slingshot::MIN_LAUNCH_SPEED * fraction;
+                Vec2 velocity = slingshot.pullVelocity(angle, 1.0f).normalized() * speed;
+
+                kind = over ? "over_speed" : "under_speed";
+                run.launches.insert(run.launches.begin(), recordedLaunch(levels[level], velocity));
+                attempts++;
+                expect = false;
+                break;
+            }
+            default:
+                break;
+            }
+
+            replay::encode(run, bytes);
+            if (std::string(kind) == "truncated")
+                bytes.pop_back();
+
+            nlohmann::json line = {{"id", n}, {"kind", kind}, {"attempts", attempts},
+                                   {"replay", replay::toHex(bytes)}, {"expect", expect}};
+            std::cout << line.dump() << '\n';
+        }
+    }
+
+    GoldenHash runGoldenScenario(const LevelDefinition &level)
+    {
+        PhysicsWorld world;
+        level.build(world);
+        for (int i = 0; i < GOLDEN_AIM_STEPS; i++)
+            world.update(physics::TIME_STEP);
+
+        world.addEntity(std::make_unique<Agent>(level.info.spawn));
+        world.getAgent()->setVel(GOLDEN_LAUNCH);
+        for (int i = 0; i < GOLDEN_FLIGHT_STEPS && world.checkAgent() == AgentOutcome::None; i++)
+            world.update(physics::TIME_STEP);
+
+        return {level.info.id, world.getTick(), world.hashState()};
+    }
+
+    bool readGoldenHashes(const std::string &path, std::vector<GoldenHash> &out)
+    {
+        std::ifstream file(path);
+        if (!file)
+            return false;
+
+        std::string line;
+        while (std::getline(file, line))
+        {
+            if (line.empty() || line[0] == '#')
+                continue;
+            GoldenHash golden;
+            unsigned long long ticks = 0;
+            unsigned long long hash = 0;
+            if (std::sscanf(line.c_str(), "%d %llu %llx", &golden.levelId, &ticks, &hash) != 3)
+            {
+                std::cerr << path << ": bad line: " << line << std::endl;
+                return false;
+            }
+            golden.ticks = ticks;
+            golden.hash = hash;
+            out.push_back(golden);
+        }
+        return true;
+    }
+
+    bool writeGoldenHashes(const std::string &path, const std::vector<LevelDefinition> &levels)
+    {
+        std::ofstream file(path);
+        if (!file)
+        {
+            std::cerr << path << ": cannot write" << std::endl;
+            return false;
+        }
+
+        file << "# World hash per level after slingshot_verify's golden scenario, from a\n"
+                "# SLINGSHOT_DETERMINISTIC build. Regenerate with slingshot_verify --update-golden.\n"
+                "# level ticks hash\n";
+        for (const auto &level : levels)
+        {
+            GoldenHash golden = runGoldenScenario(level);
+            char line[64];
+            std::snprintf(line, sizeof(line), "%d %llu %016llx\n", golden.levelId,
+                          static_cast<unsigned long long>(golden.ticks), static_cast<unsigned long long>(golden.hash));
+            file << line;
+        }
+        return true;
+    }
+
+    // Replays every level with a golden hash; levels without one are skipped.
+    // Reports each mismatch to stderr, or every level with `verbose`.
+    bool checkGoldenHashes(const std::vector<GoldenHash> &goldens, const std::vector<LevelDefinition> &levels, bool verbose)
+    {
+        bool ok = true;
+        for (const auto &golden : goldens)
+        {
+            auto level = std::find_if(levels.begin(), levels.end(), [&golden](const LevelDefinition &l)
+                                      { return l.info.id == golden.levelId; });
+            if (level == levels.end())
+                continue;
+
+            GoldenHash actual = runGoldenScenario(*level);
+            bool match = actual.ticks == golden.ticks && actual.hash == golden.hash;
+            if (!match || verbose)
+            {
+                std::fprintf(stderr, "level %d: %s (%llu ticks, %016llx; golden %llu ticks, %016llx)\n",
+                             golden.levelId, match ? "ok" : "MISMATCH",
+                             static_cast<unsigned long long>(actual.ticks), static_cast<unsigned long long>(actual.hash),
+                             static_cast<unsigned long long>(golden.ticks), static_cast<unsigned long long>(golden.hash));
+            }
+            ok = ok && match;
+        }
+
+        if (!ok)
+        {
+            std::cerr << "Physics differs from the build that wrote the golden hashes"
+                      << (physics::DETERMINISTIC ? "" : " (this build lacks SLINGSHOT_DETERMINISTIC)")
+                      << "; rerun --update-golden only if the change is intended" << std::endl;
+        }
+        return ok;
+    }
+
+    bool parseArgs(int argc, char **argv, Options &options)
+    {
+        for (int i = 1; i < argc; i++)
+        {
+            std::string arg = argv[i];
+            auto value = [&arg](const char *prefix) -> const char *
+            {
+                size_t len = std::char_traits<char>::length(prefix);
+                return arg.compare(0, len, prefix) == 0 ? arg.c_str() + len : nullptr;
+            };
+
+            if (const char *v = value("--threads="))
+                options.threads = std::max(1, std::atoi(v));
+            else if (const char *v = value("--levels="))
+                options.levelsDir = v;
+            else if (const char *v = value("--pack="))
+                options.packPath = v;
+            else if (const char *v = value("--queue="))
+                options.queueDir = v;
+            else if (const char *v = value("--generate="))
+                options.generate = std::max(0, std::atoi(v));
+            else if (const char *v = value("--seed="))
+                options.seed = static_cast<unsigned>(std::strtoul(v, nullptr, 10));
+            else if (const char *v = value("--golden="))
+                options.goldenPath = v;
+            else if (arg == "--self-check")
+                options.selfCheck = true;
+            else if (arg == "--update-golden")
+                options.updateGolden = true;
+            else if (!arg.empty() && arg[0] != '-')
+                options.files.push_back(arg);
+            else
+            {
+                std::cerr << "Unknown argument: " << arg << std::endl;
+                std::cerr << "Usage: slingshot_verify [--threads=N] [--levels=DIR | --pack=FILE] [--golden=FILE] [--queue=DIR] [FILE...]\n"
+                             "       slingshot_verify --generate=N [--seed=S] [--levels=DIR | --pack=FILE]\n"
+                             "       slingshot_verify --self-check | --update-golden [--golden=FILE] [--levels=DIR | --pack=FILE]"
+                          << std::endl;
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    Options options;
+    if (!parseArgs(argc, argv, options))
+        return 1;
+
+    std::vector<LevelDefinition> levels;
+    if (!loadLevels(options, levels))
+        return 1;
+    if (levels.empty())
+    {
+        std::cerr << "No levels found" << std::endl;
+        return 1;
+    }
+
+    if (options.generate > 0)
+    {
+        generate(options, levels);
+        return 0;
+    }
+
+    if (options.updateGolden)
+    {
+        if (!writeGoldenHashes(options.goldenPath, levels))
+            return 1;
+        std::cout << "Golden hashes written to " << options.goldenPath << std::endl;
+        return 0;
+    }
+
+    std::vector<GoldenHash> goldens;
+    if (!readGoldenHashes(options.goldenPath, goldens))
+    {
+        std::cerr << options.goldenPath << ": cannot read golden hashes; determinism is unchecked" << std::endl;
+        if (options.selfCheck)
+            return 1;
+    }
+    else if (!checkGoldenHashes(goldens, levels, options.selfCheck))
+    {
+        return 2;
+    }
+    if (options.selfCheck)
+        return 0;
+
+    std::unordered_map<int, size_t> levelIndex;
+    for (size_t i = 0; i < levels.size(); i++)
+        levelIndex[levels[i].info.id] = i;
+
+    std::vector<Submission> submissions;
+    if (!readSubmissions(options, submissions))
+        return 1;
+
+    auto start = Clock::now();
+    ThreadPool pool(options.threads);
+    std::vector<Verdict> verdicts(submissions.size());
+    pool.parallelFor(submissions.size(), VERIFY_GRAIN, [&](size_t begin, size_t end)
+                     {
+        ReplayPlayer player;
+        for (size_t i = begin; i < end; i++)
+            verdicts[i] = verify(submissions[i], levels, levelIndex, player); });
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    int accepted = 0;
+    int unexpected = 0;
+    for (size_t i = 0; i < submissions.size(); i++)
+    {
+        accepted += verdicts[i].accepted;
+        if (submissions[i].expect >= 0 && submissions[i].expect != static_cast<int>(verdicts[i].accepted))
+            unexpected++;
+        std::cout << toJson(submissions[i], verdicts[i]).dump() << '\n';
+    }
+    std::cout.flush();
+
+    std::fprintf(stderr, "%zu submissions in %.3f s (%.0f/s, %d threads): %d accepted, %zu rejected",
+                 submissions.size(), seconds, seconds > 0.0 ? submissions.size() / seconds : 0.0,
+                 pool.getThreadCount(), accepted, submissions.size() - accepted);
+    if (unexpected > 0)
+        std::fprintf(stderr, ", %d not as expected", unexpected);
+    std::fprintf(stderr, "\n");
+
+    return unexpected > 0 ? 1 : 0;
+}